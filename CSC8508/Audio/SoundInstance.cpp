@@ -23,6 +23,9 @@ SoundInstance::~SoundInstance()
 
 void SoundInstance::Play()
 {
+	//never given a sound because audio wasn't initialised
+	if (audioCore == nullptr)
+		return;
 	channelID = audioCore->coreNextChannelID++;
 	FMOD::Channel* channel = nullptr;
 
@@ -56,6 +59,8 @@ void SoundInstance::Stop()
 
 bool SoundInstance::isPlaying()
 {
+	if (audioCore == nullptr)
+		return false;
 	auto foundChannel = audioCore->coreChannels.find(channelID);
 	if (foundChannel == audioCore->coreChannels.end())
 		return false;
@@ -4,6 +4,8 @@
 #include"SoundInstance.h"
 #include"SoundListener.h"
 #include"../Engine/Transform.h"
+#include"../Engine/Profiler.h"
+#include"../Engine/AllocationTracker.h"
 #include"../../Common/Assets.h"
 
 using namespace NCL;
@@ -24,19 +26,24 @@ void SoundManager::Init()
 
 void SoundManager::Update()
 {
+	if (audioCore == nullptr)
+		return;
+	PROFILE_SCOPE("SoundManager::Update");
+	ALLOC_SCOPE(AllocTag::Audio);
 	audioCore->Update();
 }
 
 void SoundManager::Release()
 {
 	delete audioCore;
+	audioCore = nullptr;
 }
 
 void SoundManager::PlayOneShot(const std::string& soundFile, const Maths::Vector3& position)
 {
-	auto channelID = audioCore->coreNextChannelID++;
 	if (audioCore == nullptr)
 		return;
+	auto channelID = audioCore->coreNextChannelID++;
 	FMOD::Sound* sound;
 	FMOD::Channel* channel;
 	ErrorCheck(audioCore->coreSystem->createSound((Assets::AUDIODIR + soundFile).c_str(), FMOD_3D | FMOD_LOOP_OFF | FMOD_3D_LINEARSQUAREROLLOFF, 0, &sound));
@@ -79,7 +86,11 @@ void SoundManager::CreateInstance(const std::string& soundFile, SoundInstance* s
 
 void SoundManager::DeleteInstance(SoundInstance* soundInstance)
 {
+	if (audioCore == nullptr)
+		return;
 	auto foundSound = audioCore->coreSounds.find(soundInstance->path);
+	if (foundSound == audioCore->coreSounds.end())
+		return;
 	auto& foundSoundVector = (*foundSound).second;
 	auto foundSoundInstance = std::find(foundSoundVector.begin(), foundSoundVector.end(), soundInstance);
 
@@ -91,18 +102,22 @@ void SoundManager::DeleteInstance(SoundInstance* soundInstance)
 
 void SoundManager::UpdateListener(const SoundListener* listener)
 {
+	if (audioCore == nullptr)
+		return;
 	ErrorCheck(audioCore->coreSystem->set3DListenerAttributes(listener->ID, &listener->pos, &listener->vel, &listener->forward, &listener->up));
 }
 
 void SoundManager::AddListener()
 {
+	if (audioCore == nullptr)
+		return;
 	audioCore->listenersNumber++;
 	ErrorCheck(audioCore->coreSystem->set3DNumListeners(audioCore->listenersNumber));
 }
 
 void SoundManager::RemoveListener()
 {
-	if (audioCore->listenersNumber == 1)
+	if (audioCore == nullptr || audioCore->listenersNumber == 1)
 		return;
 	audioCore->listenersNumber--;
 	ErrorCheck(audioCore->coreSystem->set3DNumListeners(audioCore->listenersNumber));
@@ -110,6 +125,8 @@ void SoundManager::RemoveListener()
 
 void SoundManager::StopAllInstances()
 {
+	if (audioCore == nullptr)
+		return;
 	for (auto channel : audioCore->coreChannels)
 		ErrorCheck(channel.second->stop());
 }
@@ -121,6 +138,8 @@ bool SoundManager::IsInit()
 
 void SoundManager::Set3DSetting(float distanceFactor, float rollofscale, float dopplerScale)
 {
+	if (audioCore == nullptr)
+		return;
 	Audio::ErrorCheck(audioCore->coreSystem->set3DSettings(dopplerScale, distanceFactor, rollofscale));
 }
 
@@ -13,6 +13,7 @@ namespace NCL {
 
 			namespace SoundManager {
 
+				//until Init is called everything here does nothing, which is how headless runs go without audio
 				void Init();
 				void Update();
 				void Release();
@@ -0,0 +1,131 @@
+#include "AllocationTracker.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <new>
+
+using namespace NCL;
+using namespace CSC8508;
+
+thread_local AllocTag AllocationTracker::currentTag = AllocTag::Untagged;
+
+std::atomic<size_t> AllocationTracker::allocations[AllocationTracker::TAG_COUNT];
+std::atomic<size_t> AllocationTracker::bytes[AllocationTracker::TAG_COUNT];
+std::atomic<size_t> AllocationTracker::frees[AllocationTracker::TAG_COUNT];
+
+AllocationTracker::TagStats AllocationTracker::lastFrame[AllocationTracker::TAG_COUNT];
+size_t AllocationTracker::lastFrameAllocations = 0;
+size_t AllocationTracker::lastFrameBytes = 0;
+
+bool AllocationTracker::expectNoAllocations = false;
+int AllocationTracker::failedFrames = 0;
+
+const char* AllocationTracker::GetTagName(AllocTag tag) {
+	static const char* names[TAG_COUNT] = {
+		"Untagged", "States", "Physics", "World", "Components", "Objects",
+		"Transforms", "Render", "Network", "Audio", "Level", "Debug"
+	};
+	return tag < AllocTag::Count ? names[(int)tag] : "Unknown";
+}
+
+void AllocationTracker::EndFrame() {
+	lastFrameAllocations = 0;
+	lastFrameBytes = 0;
+
+	for (int i = 0; i < TAG_COUNT; ++i) {
+		lastFrame[i].allocations = allocations[i].exchange(0, std::memory_order_relaxed);
+		lastFrame[i].bytes = bytes[i].exchange(0, std::memory_order_relaxed);
+		lastFrame[i].frees = frees[i].exchange(0, std::memory_order_relaxed);
+
+		lastFrameAllocations += lastFrame[i].allocations;
+		lastFrameBytes += lastFrame[i].bytes;
+	}
+
+	if (expectNoAllocations && lastFrameAllocations > 0) {
+		failedFrames++;
+		std::cout << "Allocation tracker: expected no allocations but the last frame made " << lastFrameAllocations << "\n";
+		PrintLastFrame();
+	}
+}
+
+//printing allocates too, which shows up as untagged in the next frame
+void AllocationTracker::PrintLastFrame() {
+	std::cout << "Allocations last frame: " << lastFrameAllocations << " (" << lastFrameBytes << " bytes)\n";
+	for (int i = 0; i < TAG_COUNT; ++i) {
+		const TagStats& stats = lastFrame[i];
+		if (stats.allocations == 0 && stats.frees == 0)
+			continue;
+
+		std::cout << "  " << std::left << std::setw(12) << GetTagName((AllocTag)i) << std::right
+			<< std::setw(8) << stats.allocations << " allocs "
+			<< std::setw(10) << stats.bytes << " bytes "
+			<< std::setw(8) << stats.frees << " frees\n";
+	}
+	std::cout << std::flush;
+}
+
+#ifndef NCL_DISABLE_ALLOCATION_TRACKER
+//replacements for the global allocation functions. Everything else (nothrow, sized and array
+//forms) is routed through these two so nothing is counted twice or missed
+void* operator new(size_t size) {
+	AllocationTracker::RecordAllocation(size);
+	if (size == 0)
+		size = 1;
+
+	while (true) {
+		void* ptr = malloc(size);
+		if (ptr)
+			return ptr;
+
+		std::new_handler handler = std::get_new_handler();
+		if (!handler)
+			throw std::bad_alloc();
+		handler();
+	}
+}
+
+void operator delete(void* ptr) noexcept {
+	if (!ptr)
+		return;
+	AllocationTracker::RecordFree();
+	free(ptr);
+}
+
+void* operator new[](size_t size) {
+	return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+	try {
+		return operator new(size);
+	}
+	catch (...) {
+		return nullptr;
+	}
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+	return operator new(size, std::nothrow);
+}
+
+void operator delete[](void* ptr) noexcept {
+	operator delete(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+	operator delete(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+	operator delete(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+	operator delete(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+	operator delete(ptr);
+}
+#endif
@@ -0,0 +1,110 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+//ALLOC_SCOPE charges every heap allocation made by this thread, for the rest of the enclosing
+//block, to a subsystem. Jobs started inside a scope are charged to it too.
+//Defining NCL_DISABLE_ALLOCATION_TRACKER removes the scopes and leaves global new and delete alone
+#ifndef NCL_DISABLE_ALLOCATION_TRACKER
+#define ALLOC_CONCAT_INNER(a, b) a##b
+#define ALLOC_CONCAT(a, b) ALLOC_CONCAT_INNER(a, b)
+#define ALLOC_SCOPE(tag) NCL::CSC8508::AllocationScope ALLOC_CONCAT(allocScope, __LINE__)(tag)
+#else
+#define ALLOC_SCOPE(tag)
+#endif
+
+namespace NCL {
+	namespace CSC8508 {
+
+		enum class AllocTag : uint8_t {
+			Untagged,
+			States,
+			Physics,
+			World,
+			Components,
+			Objects,
+			Transforms,
+			Render,
+			Network,
+			Audio,
+			Level,
+			Debug,
+			Count
+		};
+
+		//counts every global new and delete, split by the tag active on the allocating thread.
+		//Counting is a relaxed atomic add, so it is cheap enough to leave on all the time
+		class AllocationTracker {
+		public:
+			struct TagStats {
+				size_t allocations = 0;
+				size_t bytes = 0;
+				size_t frees = 0;
+			};
+
+			//call once a frame, moves the running counts into the last frame's stats
+			static void EndFrame();
+
+			static const TagStats& GetLastFrame(AllocTag tag) { return lastFrame[(int)tag]; }
+			static size_t GetLastFrameAllocations() { return lastFrameAllocations; }
+			static size_t GetLastFrameBytes() { return lastFrameBytes; }
+			static void PrintLastFrame();
+
+			static const char* GetTagName(AllocTag tag);
+			static AllocTag GetCurrentTag() { return currentTag; }
+
+			//once on, every frame that allocates anything is reported and counted as a failure.
+			//For steady state checks, turn it on after loading and warming up
+			static void SetExpectNoAllocations(bool expect) { expectNoAllocations = expect; }
+			static int GetFailedFrameCount() { return failedFrames; }
+
+			//called by the global new and delete
+			static void RecordAllocation(size_t size) {
+				int tag = (int)currentTag;
+				allocations[tag].fetch_add(1, std::memory_order_relaxed);
+				bytes[tag].fetch_add(size, std::memory_order_relaxed);
+			}
+
+			static void RecordFree() {
+				frees[(int)currentTag].fetch_add(1, std::memory_order_relaxed);
+			}
+
+		private:
+			friend class AllocationScope;
+
+			static const int TAG_COUNT = (int)AllocTag::Count;
+
+			static thread_local AllocTag currentTag;
+
+			static std::atomic<size_t> allocations[TAG_COUNT];
+			static std::atomic<size_t> bytes[TAG_COUNT];
+			static std::atomic<size_t> frees[TAG_COUNT];
+
+			static TagStats lastFrame[TAG_COUNT];
+			static size_t lastFrameAllocations;
+			static size_t lastFrameBytes;
+
+			static bool expectNoAllocations;
+			static int failedFrames;
+		};
+
+		class AllocationScope {
+		public:
+			AllocationScope(AllocTag tag) {
+				previous = AllocationTracker::currentTag;
+				AllocationTracker::currentTag = tag;
+			}
+
+			~AllocationScope() {
+				AllocationTracker::currentTag = previous;
+			}
+
+			AllocationScope(const AllocationScope&) = delete;
+			AllocationScope& operator=(const AllocationScope&) = delete;
+
+		private:
+			AllocTag previous;
+		};
+	}
+}
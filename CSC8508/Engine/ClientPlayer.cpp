@@ -21,7 +21,7 @@ bool NCL::CSC8508::ClientPlayer::ReadPlayerFinishedPacket(PlayerFinishedPacket&
 {
 	if (p.playerID == this->playerID) {
 		NetworkPlayerComponent* player = GetNetworkPlayerComponent();
-		if (player->isFinished()) return true;
+		if (!player || player->isFinished()) return true;
 		player->SetScore(p.score);
 		std::cout << "Player " << p.playerID << " has finished the level and scored " << p.score << std::endl;
 	}
@@ -33,6 +33,7 @@ bool NCL::CSC8508::ClientPlayer::ReadPlayerStatusPacket(PlayerStatusPacket& p)
 {
 	if (p.playerID == this->playerID) {
 		NetworkPlayerComponent* player = GetNetworkPlayerComponent();
+		if (!player) return false;
 		player->SetScore(p.score);
 		player->SetIsFinished(p.isFinished);
 	}
@@ -41,6 +42,9 @@ bool NCL::CSC8508::ClientPlayer::ReadPlayerStatusPacket(PlayerStatusPacket& p)
 
 bool NCL::CSC8508::ClientPlayer::WriteDeltaPacket(GamePacket** p, int stateID)
 {
+	GameObject* object = GetObject();
+	if (!object) return false;
+
 	PlayerDeltaPacket* dp = new PlayerDeltaPacket();
 
 	dp->playerID = this->playerID;
@@ -53,8 +57,8 @@ bool NCL::CSC8508::ClientPlayer::WriteDeltaPacket(GamePacket** p, int stateID)
 
 	dp->fullID = stateID;
 
-	Vector3		currentPos = object.GetTransform().GetPosition();
-	Quaternion  currentOrientation = object.GetTransform().GetOrientation();
+	Vector3		currentPos = object->GetTransform().GetPosition();
+	Quaternion  currentOrientation = object->GetTransform().GetOrientation();
 
 	currentPos -= state.position;
 	currentOrientation -= state.orientation;
@@ -74,12 +78,15 @@ bool NCL::CSC8508::ClientPlayer::WriteDeltaPacket(GamePacket** p, int stateID)
 
 bool NCL::CSC8508::ClientPlayer::WriteFullPacket(GamePacket** p)
 {
+	GameObject* object = GetObject();
+	if (!object) return false;
+
 	PlayerFullPacket* fp = new PlayerFullPacket();
 
 	fp->playerID = this->playerID;
 	fp->objectID = networkID;
-	fp->fullState.position = object.GetTransform().GetPosition();
-	fp->fullState.orientation = object.GetTransform().GetOrientation();
+	fp->fullState.position = object->GetTransform().GetPosition();
+	fp->fullState.orientation = object->GetTransform().GetOrientation();
 	fp->fullState.stateID = lastFullState.stateID++;
 
 	*p = fp;
@@ -16,7 +16,10 @@ namespace NCL {
 
 			void Update(GamePacket& p) override;
 			int GetPlayerID() const { return playerID; }
-			NetworkPlayerComponent* GetNetworkPlayerComponent() const { return object.GetComponent<NetworkPlayerComponent>(); }
+			NetworkPlayerComponent* GetNetworkPlayerComponent() const {
+				GameObject* object = GetObject();
+				return object ? object->GetComponent<NetworkPlayerComponent>() : nullptr;
+			}
 		protected:
 
 			bool ReadPlayerFinishedPacket(PlayerFinishedPacket& p) override;
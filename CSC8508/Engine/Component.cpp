@@ -1,8 +1,21 @@
 #include "Component.h"
 #include "GameObject.h"
+#include "ComponentPool.h"
+
+#include <cassert>
 
 using namespace NCL::CSC8508;
 
+std::atomic<unsigned int> ComponentTypes::typeCount(0);
+ComponentPoolBase* ComponentPools::pools[MAX_COMPONENT_TYPES] = {};
+
+ComponentTypeID ComponentTypes::Next() {
+	//types can be seen for the first time from several threads at once
+	ComponentTypeID id = typeCount.fetch_add(1);
+	assert(id < MAX_COMPONENT_TYPES);
+	return id;
+}
+
 std::vector<std::string> Component::GetDebugInfo() {
 	std::vector<std::string> info;
 	info.push_back(name);
@@ -16,5 +29,7 @@ Component::Component(std::string name, GameObject* object) {
 	gameObject = object;
 	transform = &object->GetTransform();
 	enabled = true;
+	typeID = 0;
+	poolIndex = -1;
 	this->name = name;
 }
\ No newline at end of file
@@ -1,12 +1,35 @@
 #pragma once
 #include <vector>
 #include <string>
+#include <atomic>
 
 namespace NCL {
 	namespace CSC8508 {
 
 		class GameObject;
 		class Transform;
+		class StateWriter;
+		class StateReader;
+
+		typedef unsigned int ComponentTypeID;
+		const unsigned int MAX_COMPONENT_TYPES = 64;
+
+		//hands out a small sequential id per component type the first time it is asked for,
+		//so objects can find components by index instead of casting
+		class ComponentTypes {
+		public:
+			template<typename T>
+			static ComponentTypeID Get() {
+				static const ComponentTypeID id = Next();
+				return id;
+			}
+
+			static unsigned int Count() { return typeCount; }
+
+		private:
+			static ComponentTypeID Next();
+			static std::atomic<unsigned int> typeCount;
+		};
 
 		class Component {
 		public:
@@ -19,14 +42,28 @@ namespace NCL {
 			virtual void OnCollisionBegin(GameObject* otherObject) {};
 			virtual void OnCollisionStay(GameObject* otherObject) {};
 			virtual void OnCollisionEnd(GameObject* otherObject) {};
+			virtual void OnTriggerEnter(GameObject* otherObject) {};
+			virtual void OnTriggerExit(GameObject* otherObject) {};
 			virtual void OnActive() {};
 			virtual void OnKill() {};
 			std::vector<std::string> GetDebugInfo();
 
+			//thread safe components of a type are updated in parallel. Their Update may only read
+			//other objects and must change anything outside the component through GameWorld::Defer.
+			//Every component of one type has to give the same answer
+			virtual bool IsThreadSafe() const { return false; }
+
+			//level restarts put components back as they were when the level was captured. Anything
+			//that can change during play is written here and read back in the same order
+			virtual void SaveState(StateWriter& state) const {}
+			virtual void RestoreState(StateReader& state) {}
+
 			bool IsEnabled() const		{ return enabled; }
 			void SetEnabled(bool val)	{ enabled = val; }
 
 			std::string GetName() { return name; }
+			ComponentTypeID GetTypeID() const { return typeID; }
+			GameObject* GetGameObject() const { return gameObject; }
 
 		protected:
 			virtual std::vector<std::string> DebugInfo() { return std::vector<std::string>(); }
@@ -35,8 +72,13 @@ namespace NCL {
 			Transform* transform;
 
 		private:
+			friend class GameObject;
+			friend class ComponentPoolBase;
+
 			bool enabled;
 			std::string name;
+			ComponentTypeID typeID;
+			int poolIndex;
 		};
 
 	}
@@ -0,0 +1,113 @@
+#pragma once
+#include "Component.h"
+
+#include <vector>
+#include <new>
+
+namespace NCL {
+	namespace CSC8508 {
+
+		//type erased side of a pool, enough for the world to walk every component of one type
+		//and for an object to hand a component back without knowing its type
+		class ComponentPoolBase {
+		public:
+			virtual ~ComponentPoolBase() {}
+			virtual void Release(Component* component) = 0;
+
+			//dense list of live components of this type, in no particular order
+			const std::vector<Component*>& GetComponents() const { return live; }
+
+		protected:
+			void AddLive(Component* component) {
+				component->poolIndex = (int)live.size();
+				live.push_back(component);
+			}
+
+			void RemoveLive(Component* component) {
+				Component* last = live.back();
+				live[component->poolIndex] = last;
+				last->poolIndex = component->poolIndex;
+				live.pop_back();
+				component->poolIndex = -1;
+			}
+
+			std::vector<Component*> live;
+		};
+
+		//stores components of one type side by side in fixed size blocks. Blocks are never moved
+		//so pointers stay valid, freed slots are reused before a new block is allocated
+		template<typename T>
+		class ComponentPool : public ComponentPoolBase {
+		public:
+			~ComponentPool() {
+				for (auto block : blocks)
+					::operator delete(block);
+			}
+
+			template<typename... Params>
+			T* Create(Params... vals) {
+				if (freeSlots.empty())
+					AddBlock();
+
+				T* slot = freeSlots.back();
+				freeSlots.pop_back();
+
+				T* component = new (slot) T(vals...);
+				AddLive(component);
+				return component;
+			}
+
+			void Release(Component* component) override {
+				RemoveLive(component);
+
+				T* t = static_cast<T*>(component);
+				t->~T();
+				freeSlots.push_back(t);
+			}
+
+		private:
+			static const int BLOCK_SIZE = 64;
+
+			void AddBlock() {
+				T* block = static_cast<T*>(::operator new(sizeof(T) * BLOCK_SIZE));
+				blocks.push_back(block);
+
+				//pushed in reverse so the block is filled front to back
+				for (int i = BLOCK_SIZE - 1; i >= 0; --i)
+					freeSlots.push_back(block + i);
+			}
+
+			std::vector<T*> blocks;
+			std::vector<T*> freeSlots;
+		};
+
+		//one pool per component type, indexed by component type id
+		class ComponentPools {
+		public:
+			template<typename T>
+			static ComponentPool<T>& Get() {
+				static ComponentPool<T>* pool = Register<T>();
+				return *pool;
+			}
+
+			//null if no component of that type has ever been created
+			static ComponentPoolBase* Get(ComponentTypeID id) {
+				return pools[id];
+			}
+
+			static void Release(Component* component) {
+				pools[component->GetTypeID()]->Release(component);
+			}
+
+		private:
+			template<typename T>
+			static ComponentPool<T>* Register() {
+				ComponentPool<T>* pool = new ComponentPool<T>();
+				pools[ComponentTypes::Get<T>()] = pool;
+				return pool;
+			}
+
+			static ComponentPoolBase* pools[MAX_COMPONENT_TYPES];
+		};
+	}
+}
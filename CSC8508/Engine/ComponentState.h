@@ -0,0 +1,55 @@
+#pragma once
+#include <vector>
+#include <cstring>
+#include <type_traits>
+
+#include "../../Common/Vector3.h"
+
+namespace NCL {
+	namespace CSC8508 {
+
+		//components save whatever can change during play as plain values, appended to one buffer
+		class StateWriter {
+		public:
+			StateWriter(std::vector<char>& buffer) : buffer(buffer) {}
+
+			template<typename T>
+			void Write(const T& value) {
+				static_assert(std::is_trivially_copyable<T>::value, "Component state has to be plain data");
+				const char* bytes = reinterpret_cast<const char*>(&value);
+				buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+			}
+
+			void Write(const Maths::Vector3& value) {
+				Write(value.x);
+				Write(value.y);
+				Write(value.z);
+			}
+
+		private:
+			std::vector<char>& buffer;
+		};
+
+		//reads values back in the order they were written
+		class StateReader {
+		public:
+			StateReader(const char* data) : data(data) {}
+
+			template<typename T>
+			void Read(T& value) {
+				static_assert(std::is_trivially_copyable<T>::value, "Component state has to be plain data");
+				memcpy(&value, data, sizeof(T));
+				data += sizeof(T);
+			}
+
+			void Read(Maths::Vector3& value) {
+				Read(value.x);
+				Read(value.y);
+				Read(value.z);
+			}
+
+		private:
+			const char* data;
+		};
+	}
+}
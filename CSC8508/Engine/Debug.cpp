@@ -1,5 +1,6 @@
 #include "Debug.h"
 #include "../../Common/Matrix4.h"
+#include "AllocationTracker.h"
 
 using namespace NCL;
 
@@ -59,7 +60,11 @@ void Debug::DrawAxisLines(const Matrix4& modelMatrix, float scaleBoost, float ti
 
 
 void Debug::FlushRenderables(float dt) {
+	ALLOC_SCOPE(CSC8508::AllocTag::Debug);
+	//nothing to draw with when headless, but the queues still can't grow forever
 	if (!renderer) {
+		stringEntries.clear();
+		lineEntries.clear();
 		return;
 	}
 	for (const auto& i : stringEntries) {
@@ -12,6 +12,7 @@ using namespace NCL::CSC8508;
 GameObject::GameObject(string objectName) : transform(this)	{
 	name			= objectName;
 	worldID			= -1;
+	worldIndex		= -1;
 	isActive		= true;
 	isStatic		= false;
 	destroy			= false;
@@ -19,7 +20,12 @@ GameObject::GameObject(string objectName) : transform(this)	{
 	boundingVolume	= nullptr;
 	physicsObject	= nullptr;
 	renderObject	= nullptr;
+	world			= nullptr;
+	started			= false;
 	collisionLayer = 0;
+
+	for (int i = 0; i < ActiveListCount; ++i)
+		activeListSlots[i] = -1;
 }
 
 GameObject::~GameObject()	{
@@ -28,12 +34,86 @@ GameObject::~GameObject()	{
 	delete renderObject;
 
 	for (auto component : components)
-		delete component;
+		ComponentPools::Release(component);
 	
 	components.clear();
 
 }
 
+void GameObject::Destroy() {
+	if (destroy)
+		return;
+
+	destroy = true;
+
+	if (world)
+		world->QueueDestroy(this);
+}
+
+void GameObject::AddTag(TagID tag) {
+	if (tag >= MAX_TAGS || tags.test(tag))
+		return;
+
+	tags.set(tag);
+
+	if (world)
+		world->AddToTagIndex(this, tag);
+}
+
+void GameObject::AttachComponent(Component* component, ComponentTypeID id) {
+	component->typeID = id;
+	components.push_back(component);
+
+	if (componentMask.test(id))
+		return;
+
+	if (componentSlots.size() <= id)
+		componentSlots.resize(id + 1, nullptr);
+
+	componentSlots[id] = component;
+	componentMask.set(id);
+	RefreshActiveLists();
+}
+
+void GameObject::DetachComponents(ComponentTypeID id) {
+	if (!componentMask.test(id))
+		return;
+
+	for (int i = components.size() - 1; i >= 0; --i) {
+		if (components[i]->GetTypeID() == id) {
+			ComponentPools::Release(components[i]);
+			components.erase(components.begin() + i);
+		}
+	}
+
+	componentSlots[id] = nullptr;
+	componentMask.reset(id);
+	RefreshActiveLists();
+}
+
+//a type's slot holds its first component, so a slot pointing past count has no earlier one to fall back to
+void GameObject::DetachComponentsFrom(size_t count) {
+	if (components.size() <= count)
+		return;
+
+	for (size_t i = count; i < components.size(); ++i) {
+		ComponentTypeID id = components[i]->GetTypeID();
+		if (componentSlots[id] == components[i]) {
+			componentSlots[id] = nullptr;
+			componentMask.reset(id);
+		}
+		ComponentPools::Release(components[i]);
+	}
+
+	components.resize(count);
+	RefreshActiveLists();
+}
+
+void GameObject::RefreshActiveLists() {
+	if (world)
+		world->UpdateActiveLists(this);
+}
+
 void GameObject::SetIsActive(bool val) {
 
 	if (isActive == val)
@@ -44,6 +124,8 @@ void GameObject::SetIsActive(bool val) {
 	if (physicsObject && physicsObject->body)
 		physicsObject->body->setActive(val);
 
+	RefreshActiveLists();
+
 	if (val == true) {
 		for (auto component : components) {
 			if (component->IsEnabled())
@@ -53,6 +135,7 @@ void GameObject::SetIsActive(bool val) {
 }
 
 void GameObject::Start() {
+	started = true;
 
 	for (int i{ 0 }; i < components.size(); ++i)
 	{
@@ -60,16 +143,12 @@ void GameObject::Start() {
 	}
 }
 
+//components aren't updated here, the world updates them type by type from their pools
 void GameObject::Update(float dt)
 {
 	if (!isActive)
 		return;
 
-	for (auto component : components) {
-		if (component->IsEnabled())
-			component->Update(dt);
-	}
-
 	if(renderObject)
 		renderObject->Update(dt);
 
@@ -117,8 +196,30 @@ void GameObject::OnCollisionEnd(GameObject* otherObject)
 	}
 }
 
+void GameObject::OnTriggerEnter(GameObject* otherObject)
+{
+	if (!isActive)
+		return;
+
+	for (auto component : components) {
+		component->OnTriggerEnter(otherObject);
+	}
+}
+
+void GameObject::OnTriggerExit(GameObject* otherObject)
+{
+	if (!isActive)
+		return;
+
+	for (auto component : components) {
+		component->OnTriggerExit(otherObject);
+	}
+}
+
+//the body is left alone, components such as respawning ones may bring the object straight back
 void GameObject::OnKill() {
 	isActive = false;
+	RefreshActiveLists();
 	for (auto component : components) {
 		component->OnKill();
 	}
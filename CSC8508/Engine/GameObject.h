@@ -3,8 +3,13 @@
 #include "CollisionVolume.h"
 #include "PhysicsObject.h"
 #include "RenderObject.h"
+#include "Component.h"
+#include "ComponentPool.h"
+#include "Tags.h"
+#include "LevelArena.h"
+#include "GameObjectHandle.h"
 
-#include <unordered_set>
+#include <bitset>
 #include <algorithm>
 
 using std::vector;
@@ -15,7 +20,15 @@ namespace NCL {
 		class Component;
 		class GameWorld;
 
-		class GameObject	{
+		//lists the world keeps so per frame loops only visit objects with work to do
+		enum ActiveList {
+			UpdatableList,	//active, with components
+			DynamicList,	//active, not static
+			AnimatedList,	//active, with an animated render object
+			ActiveListCount
+		};
+
+		class GameObject : public ArenaAllocated	{
 
 			friend class GameWorld;
 
@@ -36,7 +49,8 @@ namespace NCL {
 
 			void fixedUpdate(float dt);
 
-			void Destroy() { destroy = true; }
+			//queued with the world and deleted at the start of its next update
+			void Destroy();
 			
 			//Override to add debug info
 			virtual void ObjectSpecificDebugInfo(int& currLine, float lineSpacing) const {};
@@ -71,14 +85,23 @@ namespace NCL {
 
 			void SetIsStatic(bool val) {
 				isStatic = val;
+				RefreshActiveLists();
+			}
+
+			void AddTag(const std::string& tag) {
+				AddTag(Tags::Intern(tag));
 			}
 
-			void AddTag(std::string tag) {
-				tags.insert(tag);
+			//INVALID_TAG is ignored
+			void AddTag(TagID tag);
+
+			bool HasTag(TagID tag) const {
+				return tag < MAX_TAGS && tags.test(tag);
 			}
 
-			bool HasTag(std::string tag) {
-				return tags.find(tag) != tags.end();			
+			//looks the name up each call, cache the id from Tags::Intern on hot paths
+			bool HasTag(const std::string& tag) const {
+				return HasTag(Tags::Find(tag));
 			}
 
 			GameWorld* GetWorld() { return world; }
@@ -101,6 +124,7 @@ namespace NCL {
 
 			void SetRenderObject(RenderObject* newObject) {
 				renderObject = newObject;
+				RefreshActiveLists();
 			}
 
 			void SetPhysicsObject(PhysicsObject* newObject) {
@@ -116,6 +140,8 @@ namespace NCL {
 			void OnCollisionBegin(GameObject* otherObject);
 			void OnCollisionStay(GameObject* otherObject);
 			void OnCollisionEnd(GameObject* otherObject);
+			void OnTriggerEnter(GameObject* otherObject);
+			void OnTriggerExit(GameObject* otherObject);
 
 			bool GetBroadphaseAABB(Vector3&outsize) const;
 
@@ -129,41 +155,56 @@ namespace NCL {
 				return worldID;
 			}
 
+			//null until the object is added to a world
+			GameObjectHandle GetHandle() const {
+				return handle;
+			}
+
 			template<typename T, typename... Params>
 			T* AddComponent(Params... vals) {
-				T* component = new T(this, vals...);
-				components.push_back(component);
+				T* component = ComponentPools::Get<T>().Create(this, vals...);
+				AttachComponent(component, ComponentTypes::Get<T>());
 				return component;
 			}
 
+			//components are looked up by exact type, the slot holds the first one added of each type
 			template<typename T>
 			T* GetComponent() const {
-				for (auto component : components) {
-					T* t = dynamic_cast<T*>(component);
-		
-					if (t != nullptr) {
-						return t;
-					}
-				}
-		
-				return nullptr;
+				ComponentTypeID id = ComponentTypes::Get<T>();
+				if (!componentMask.test(id))
+					return nullptr;
+
+				return static_cast<T*>(componentSlots[id]);
+			}
+
+			template<typename T>
+			bool HasComponent() const {
+				return componentMask.test(ComponentTypes::Get<T>());
 			}
 
 			template<typename T>
 			void RemoveComponent() {
-				for (int i = components.size() - 1; i >= 0; --i) {
-					if (dynamic_cast<T*>(components[i]) != nullptr) {
-						delete components[i];
-						components.erase(components.begin() + i);
-					}
-				}
+				DetachComponents(ComponentTypes::Get<T>());
 			}
 
+			const std::vector<Component*>& GetComponents() const {
+				return components;
+			}
+
+			//re-checks which of the world's active lists the object belongs in, called whenever
+			//anything they depend on changes
+			void RefreshActiveLists();
+
 		protected:
 
 			void Start();
 			void SetGameWorld(GameWorld* world);
 
+			void AttachComponent(Component* component, ComponentTypeID id);
+			void DetachComponents(ComponentTypeID id);
+			//releases every component after the first count
+			void DetachComponentsFrom(size_t count);
+
 			Transform			transform;
 
 			CollisionVolume*	boundingVolume;
@@ -175,13 +216,23 @@ namespace NCL {
 			bool	isStatic;
 			bool	persistent;
 			bool	destroy;
+			bool	started;
 
 			int		worldID;
+			//slot in the world's object list, and in each of its tag lists, for swap removal
+			int		worldIndex;
+			GameObjectHandle handle;
+			std::vector<std::pair<TagID, int>> tagSlots;
+			//slot in each of the world's active lists, -1 if not in it
+			int		activeListSlots[ActiveListCount];
 			int collisionLayer;
 			string	name;
 			Vector3 broadphaseAABB;
-			std::unordered_set<std::string> tags;
+			std::bitset<MAX_TAGS> tags;
 			std::vector<Component*> components;
+			//indexed by component type id, only valid where the mask bit is set
+			std::vector<Component*> componentSlots;
+			std::bitset<MAX_COMPONENT_TYPES> componentMask;
 		};
 	}
 }
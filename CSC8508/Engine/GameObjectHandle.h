@@ -0,0 +1,28 @@
+#pragma once
+
+namespace NCL {
+	namespace CSC8508 {
+
+		//refers to a GameObject through its world's handle table instead of by pointer. The slot's
+		//generation changes whenever the object leaves the world, so a handle to a deleted object
+		//resolves to nullptr rather than dangling
+		struct GameObjectHandle {
+			unsigned int index		= 0xFFFFFFFF;
+			unsigned int generation	= 0;
+
+			bool IsNull() const { return index == 0xFFFFFFFF; }
+
+			bool operator==(const GameObjectHandle& other) const {
+				return index == other.index && generation == other.generation;
+			}
+
+			bool operator!=(const GameObjectHandle& other) const {
+				return !(*this == other);
+			}
+
+			bool operator<(const GameObjectHandle& other) const {
+				return index != other.index ? index < other.index : generation < other.generation;
+			}
+		};
+	}
+}
@@ -1,6 +1,10 @@
 #include "GameWorld.h"
 #include "Constraint.h"
 #include "CollisionDetection.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "AllocationTracker.h"
+#include "ComponentState.h"
 
 #include "../../Common/Camera.h"
 
@@ -10,6 +14,11 @@
 using namespace NCL;
 using namespace NCL::CSC8508;
 
+namespace {
+	//component updates are short, smaller batches cost more to hand out than they save
+	const int MIN_COMPONENTS_PER_JOB = 32;
+}
+
 GameWorld::GameWorld() {
 	objectTree = new QuadTree<GameObject*>(Vector2(1024, 1024), 10, 6);
 	staticObjectTree = new QuadTree<GameObject*>(Vector2(1024, 1024), 7, 6);
@@ -28,7 +37,12 @@ GameWorld::~GameWorld()	{
 }
 
 void GameWorld::Clear() {
+	ReleaseAllHandles();
 	gameObjects.clear();
+	for (auto& list : activeLists)
+		list.clear();
+	destroyQueue.clear();
+	taggedObjects.clear();
 	newGameObjects.clear();
 	constraints.clear();
 	killPlanes.clear();
@@ -38,13 +52,24 @@ void GameWorld::Clear() {
 }
 
 void GameWorld::ClearAndErase() {
-	for (int i = gameObjects.size() - 1; i >= 0; --i) {
-		//We have to do this manually because some objects may be persistent.
-		if (!gameObjects[i]->IsPersistent()) {
-			delete gameObjects[i];
-			gameObjects.erase(gameObjects.begin() + i);
+	FlushDestroyQueue();
+
+	//We have to do this manually because some objects may be persistent.
+	//Persistent objects are packed down to the front in one pass
+	size_t kept = 0;
+	for (size_t i = 0; i < gameObjects.size(); ++i) {
+		GameObject* o = gameObjects[i];
+		if (o->IsPersistent()) {
+			o->worldIndex = (int)kept;
+			gameObjects[kept++] = o;
+		}
+		else {
+			ReleaseHandle(o);
+			delete o;
 		}
 	}
+	gameObjects.resize(kept);
+	RebuildActiveLists();
 	for (auto& i : constraints) {
 		delete i;
 	}
@@ -56,6 +81,9 @@ void GameWorld::ClearAndErase() {
 	killPlanes.clear();
 	staticObjectTree->Clear();
 	objectTree->Clear();
+
+	//only persistent objects are left
+	RebuildTagIndex();
 }
 
 void GameWorld::ForceClearAndErase() {
@@ -71,37 +99,162 @@ void GameWorld::ForceClearAndErase() {
 	Clear();
 }
 
-std::vector<GameObject*> GameWorld::GetObjectsWithTag(std::string tag) const {
-	std::vector<GameObject*> objectsWithTag;
-	for (auto go : gameObjects)
-	{
-		if (go->HasTag(tag))
-			objectsWithTag.push_back(go);
+void GameWorld::CaptureSnapshot(/*OUT*/ WorldSnapshot& snapshot) const {
+	snapshot.Clear();
+	snapshot.objects.reserve(gameObjects.size());
+	StateWriter writer(snapshot.componentState);
+
+	for (auto o : gameObjects) {
+		if (o->IsPersistent() || o->destroy)
+			continue;
+
+		ObjectSnapshot state;
+		state.handle			= o->handle;
+		state.position			= o->transform.GetPosition();
+		state.orientation		= o->transform.GetOrientation();
+		state.scale				= o->transform.GetScale();
+		state.isActive			= o->isActive;
+		state.firstComponent	= (unsigned int)snapshot.componentTypes.size();
+		state.componentCount	= (unsigned int)o->components.size();
+
+		for (auto component : o->components) {
+			snapshot.componentTypes.push_back(component->GetTypeID());
+			writer.Write(component->IsEnabled());
+			component->SaveState(writer);
+		}
+		snapshot.objects.push_back(state);
+	}
+}
+
+//objects and components are reused rather than created again, so nothing here allocates once
+//the world's own lists have grown to fit
+bool GameWorld::RestoreSnapshot(const WorldSnapshot& snapshot) {
+	FlushDestroyQueue();
+
+	for (auto const& state : snapshot.objects) {
+		GameObject* o = GetObject(state.handle);
+		if (!o || o->components.size() < state.componentCount)
+			return false;
+
+		for (unsigned int i = 0; i < state.componentCount; ++i) {
+			if (o->components[i]->GetTypeID() != snapshot.componentTypes[state.firstComponent + i])
+				return false;
+		}
 	}
 
-	return objectsWithTag;
+	snapshotMarks.assign(handleSlots.size(), false);
+	for (auto const& state : snapshot.objects)
+		snapshotMarks[state.handle.index] = true;
 
+	//backwards, so swap removal only moves objects that have already been checked
+	for (int i = (int)gameObjects.size() - 1; i >= 0; --i) {
+		GameObject* o = gameObjects[i];
+		if (!o->IsPersistent() && !snapshotMarks[o->handle.index])
+			RemoveGameObject(o, true);
+	}
+
+	StateReader reader(snapshot.componentState.data());
+	for (auto const& state : snapshot.objects) {
+		GameObject* o = GetObject(state.handle);
+
+		o->DetachComponentsFrom(state.componentCount);
+		for (auto component : o->components) {
+			bool enabled;
+			reader.Read(enabled);
+			component->SetEnabled(enabled);
+			component->RestoreState(reader);
+		}
+
+		//bodies are put back by the physics snapshot
+		o->transform.SetPosition(state.position, false);
+		o->transform.SetOrientation(state.orientation, false);
+		o->transform.SetScale(state.scale);
+		o->SetIsActive(state.isActive);
+
+		if (o->started) {
+			o->started = false;
+			newGameObjects.push_back(o);
+		}
+	}
+	return true;
 }
 
-GameObject* NCL::CSC8508::GameWorld::GetObjectWithTag(std::string tag) const
-{
-	for (auto go : gameObjects)
-	{
-		if (go->HasTag(tag))
-			return go;
+const std::vector<GameObject*>& GameWorld::GetObjectsWithTag(TagID tag) const {
+	static const std::vector<GameObject*> noObjects;
+
+	if (tag >= taggedObjects.size())
+		return noObjects;
+
+	return taggedObjects[tag];
+}
+
+const std::vector<GameObject*>& GameWorld::GetObjectsWithTag(const std::string& tag) const {
+	return GetObjectsWithTag(Tags::Find(tag));
+}
+
+GameObject* GameWorld::GetObjectWithTag(TagID tag) const {
+	const std::vector<GameObject*>& objects = GetObjectsWithTag(tag);
+	return objects.empty() ? nullptr : objects[0];
+}
+
+GameObject* GameWorld::GetObjectWithTag(const std::string& tag) const {
+	return GetObjectWithTag(Tags::Find(tag));
+}
+
+void GameWorld::AddToTagIndex(GameObject* o, TagID tag) {
+	if (taggedObjects.size() <= tag)
+		taggedObjects.resize(tag + 1);
+
+	o->tagSlots.push_back(std::make_pair(tag, (int)taggedObjects[tag].size()));
+	taggedObjects[tag].push_back(o);
+}
+
+//swap removes the object from each of its tag lists, fixing up the slot of whichever object moves
+void GameWorld::RemoveFromTagIndex(GameObject* o) {
+	for (auto const& tagSlot : o->tagSlots) {
+		std::vector<GameObject*>& objects = taggedObjects[tagSlot.first];
+		GameObject* last = objects.back();
+		objects[tagSlot.second] = last;
+		objects.pop_back();
+
+		for (auto& lastSlot : last->tagSlots) {
+			if (lastSlot.first == tagSlot.first)
+				lastSlot.second = tagSlot.second;
+		}
+	}
+	o->tagSlots.clear();
+}
+
+void GameWorld::RebuildTagIndex() {
+	for (auto& objects : taggedObjects)
+		objects.clear();
+
+	for (auto o : gameObjects) {
+		o->tagSlots.clear();
+		for (TagID tag = 0; tag < Tags::Count(); ++tag) {
+			if (o->HasTag(tag))
+				AddToTagIndex(o, tag);
+		}
 	}
-	return nullptr;
 }
 
 GameObject* GameWorld::AddGameObject(GameObject* o) {
 
 	//For debugging, we should not be adding duplicate objects to the world.
-	assert(std::find(gameObjects.begin(), gameObjects.end(), o) == gameObjects.end());
+	assert(o->worldIndex == -1);
 
+	o->worldIndex = (int)gameObjects.size();
 	gameObjects.emplace_back(o);
 	newGameObjects.emplace_back(o);
 	o->SetGameWorld(this);
 	o->SetWorldID(worldIDCounter++);
+	AllocateHandle(o);
+	UpdateActiveLists(o);
+
+	for (TagID tag = 0; tag < Tags::Count(); ++tag) {
+		if (o->HasTag(tag))
+			AddToTagIndex(o, tag);
+	}
 	
 	if (o->IsStatic()) {
 		o->UpdateBroadphaseAABB();
@@ -111,14 +264,149 @@ GameObject* GameWorld::AddGameObject(GameObject* o) {
 		}
 	}
 
+	if (o->destroy)
+		destroyQueue.push_back(o);
+
 	return o;
 }
 
+//the last object is swapped into the removed object's slot, so this doesn't search the list
 void GameWorld::RemoveGameObject(GameObject* o, bool andDelete) {
-	gameObjects.erase(std::remove(gameObjects.begin(), gameObjects.end(), o), gameObjects.end());
+	if (o->worldIndex == -1)
+		return;
+
+	GameObject* last = gameObjects.back();
+	gameObjects[o->worldIndex] = last;
+	last->worldIndex = o->worldIndex;
+	gameObjects.pop_back();
+	o->worldIndex = -1;
+	ReleaseHandle(o);
+	UpdateActiveLists(o);
+
+	//only happens if something deletes a destroyed object itself before the queue is flushed
+	if (o->destroy && andDelete)
+		destroyQueue.erase(std::remove(destroyQueue.begin(), destroyQueue.end(), o), destroyQueue.end());
+
+	if (!o->started)
+		newGameObjects.erase(std::remove(newGameObjects.begin(), newGameObjects.end(), o), newGameObjects.end());
+
+	RemoveFromTagIndex(o);
 	if (andDelete) {
 		delete o;
 	}
+	else {
+		o->world = nullptr;
+	}
+}
+
+void GameWorld::AllocateHandle(GameObject* o) {
+	unsigned int index;
+	if (!freeHandles.empty()) {
+		index = freeHandles.back();
+		freeHandles.pop_back();
+	}
+	else {
+		index = (unsigned int)handleSlots.size();
+		handleSlots.push_back({ nullptr, 0 });
+	}
+
+	handleSlots[index].object = o;
+	o->handle.index = index;
+	o->handle.generation = handleSlots[index].generation;
+}
+
+//bumping the generation is what makes every outstanding handle to the object stale
+void GameWorld::ReleaseHandle(GameObject* o) {
+	if (o->handle.IsNull())
+		return;
+
+	HandleSlot& slot = handleSlots[o->handle.index];
+	slot.object = nullptr;
+	slot.generation++;
+	freeHandles.push_back(o->handle.index);
+	o->handle = GameObjectHandle();
+}
+
+void GameWorld::ReleaseAllHandles() {
+	freeHandles.clear();
+	for (unsigned int i = 0; i < handleSlots.size(); ++i) {
+		handleSlots[i].object = nullptr;
+		handleSlots[i].generation++;
+		freeHandles.push_back(i);
+	}
+}
+
+void GameWorld::QueueDestroy(GameObject* o) {
+	destroyQueue.push_back(o);
+}
+
+//deletes everything destroyed since the last update, each removal is constant time
+void GameWorld::FlushDestroyQueue() {
+	//swapped out first, anything destroyed by these objects' destructors waits for the next update
+	destroying.swap(destroyQueue);
+	for (size_t i = 0; i < destroying.size(); ++i) {
+		RemoveGameObject(destroying[i], true);
+	}
+	destroying.clear();
+}
+
+//walks every component pool in type order. Components belonging to other worlds, inactive objects
+//or objects that haven't started yet are skipped, as are components added during this pass
+void GameWorld::UpdateComponents(float dt) {
+	PROFILE_SCOPE("GameWorld::UpdateComponents");
+	ALLOC_SCOPE(AllocTag::Components);
+	if (deferred.size() < JobSystem::GetThreadCount())
+		deferred.resize(JobSystem::GetThreadCount());
+
+	for (ComponentTypeID id = 0; id < ComponentTypes::Count(); ++id) {
+		ComponentPoolBase* pool = ComponentPools::Get(id);
+		if (!pool)
+			continue;
+
+		const std::vector<Component*>& components = pool->GetComponents();
+		if (components.empty())
+			continue;
+
+		if (components[0]->IsThreadSafe()) {
+			//thread safe components can't add or remove components, so the list is fixed here
+			JobSystem::ParallelFor((int)components.size(), MIN_COMPONENTS_PER_JOB, [&](int begin, int end) {
+				UpdateComponentRange(components, begin, end, dt);
+			});
+		}
+		else
+			UpdateComponentRange(components, 0, components.size(), dt);
+	}
+
+	FlushDeferred();
+}
+
+void GameWorld::UpdateComponentRange(const std::vector<Component*>& components, size_t begin, size_t end, float dt) {
+	//serial updates can remove components of their own type, so keep checking the size
+	for (size_t i = begin; i < end && i < components.size(); ++i) {
+		Component* component = components[i];
+		GameObject* owner = component->GetGameObject();
+
+		if (owner->world == this && owner->started && owner->IsActive() && component->IsEnabled())
+			component->Update(dt);
+	}
+}
+
+void GameWorld::Defer(const std::function<void()>& f) {
+	unsigned int thread = JobSystem::GetThreadIndex();
+	if (thread >= deferred.size()) {
+		//only the main thread can get here, before the first update
+		deferred.resize(thread + 1);
+	}
+	deferred[thread].push_back(f);
+}
+
+//applied in thread order, writes from the same thread keep the order they were made in
+void GameWorld::FlushDeferred() {
+	for (auto& list : deferred) {
+		for (size_t i = 0; i < list.size(); ++i)
+			list[i]();
+		list.clear();
+	}
 }
 
 void GameWorld::AddKillPlane(Plane* p) {
@@ -146,6 +434,13 @@ void GameWorld::OperateOnContents(GameObjectFunc f) {
 }
 
 void GameWorld::UpdateWorld(float dt) {
+	UpdateSimulation(dt);
+	UpdateObjects(dt);
+}
+
+void GameWorld::UpdateSimulation(float dt) {
+	PROFILE_SCOPE("GameWorld::UpdateSimulation");
+	ALLOC_SCOPE(AllocTag::World);
 
 	if (newGameObjects.size() > 0) {
 		for (size_t i = 0; i < newGameObjects.size(); i++)
@@ -155,28 +450,33 @@ void GameWorld::UpdateWorld(float dt) {
 		newGameObjects.clear();
 	}
 
+	FlushDestroyQueue();
+
 	objectTree->Clear();
 	
-	for (int i = gameObjects.size() - 1; i >= 0; --i) {
-
-		auto* g = gameObjects[i];
+	{
+		PROFILE_SCOPE("GameWorld::Broadphase");
+		//backwards, so an object dropping out of the list during OnKill doesn't skip another
+		const std::vector<GameObject*>& dynamicObjects = activeLists[DynamicList];
+		for (int i = (int)dynamicObjects.size() - 1; i >= 0; --i) {
+			if (i >= (int)dynamicObjects.size())
+				continue;
 
-		if (g->destroy)
-		{
-			RemoveGameObject(g, true);
-			continue;
-		}
+			auto* g = dynamicObjects[i];
 
-		if (!g->IsStatic() && g->IsActive()) {
 			g->UpdateBroadphaseAABB();
-			Vector3 gPos = g->GetTransform().GetPosition();
+			Vector3 gPos = g->GetTransform().GetWorldPosition();
 			for (auto p : killPlanes) {
 				if (p->IsBehindPlane(gPos)) {
 					std::cout << "Object \"" << g->GetName() << "\" is out of bounds.\n";
 					g->OnKill();
+					break;
 				}
 			}
 
+			if (!g->IsActive())
+				continue;
+
 			Vector3 halfSizes;
 			if (!g->GetBroadphaseAABB(halfSizes)) {
 				continue;
@@ -184,16 +484,16 @@ void GameWorld::UpdateWorld(float dt) {
 
 			Vector3 pos = gPos;
 			objectTree->Insert(g, pos, halfSizes);
-		}	
+		}
 	}
 
 	//This must be done after generating object tree as some updates may want to test collisions
-	for (auto g : gameObjects) {
-		g->Update(dt);
-	}
+	UpdateComponents(dt);
 
 	if (shuffleObjects) {
 		std::random_shuffle(gameObjects.begin(), gameObjects.end());
+		for (int i = 0; i < (int)gameObjects.size(); ++i)
+			gameObjects[i]->worldIndex = i;
 	}
 
 	if (shuffleConstraints) {
@@ -204,6 +504,53 @@ void GameWorld::UpdateWorld(float dt) {
 		objectTree->DebugDraw();
 }
 
+void GameWorld::UpdateObjects(float dt) {
+	PROFILE_SCOPE("GameWorld::UpdateObjects");
+	ALLOC_SCOPE(AllocTag::Objects);
+	for (auto g : activeLists[AnimatedList])
+		g->GetRenderObject()->Update(dt);
+
+	for (auto g : activeLists[UpdatableList])
+		g->OnUpdate(dt);
+}
+
+void GameWorld::UpdateActiveLists(GameObject* o) {
+	bool active = o->world == this && o->worldIndex != -1 && o->isActive;
+
+	bool wanted[ActiveListCount];
+	wanted[UpdatableList]	= active && !o->components.empty();
+	wanted[DynamicList]		= active && !o->isStatic;
+	wanted[AnimatedList]	= active && o->renderObject && o->renderObject->GetAnimation();
+
+	for (int i = 0; i < ActiveListCount; ++i) {
+		std::vector<GameObject*>& list = activeLists[i];
+		int& slot = o->activeListSlots[i];
+
+		if (wanted[i] && slot == -1) {
+			slot = (int)list.size();
+			list.push_back(o);
+		}
+		else if (!wanted[i] && slot != -1) {
+			GameObject* last = list.back();
+			list[slot] = last;
+			last->activeListSlots[i] = slot;
+			list.pop_back();
+			slot = -1;
+		}
+	}
+}
+
+void GameWorld::RebuildActiveLists() {
+	for (auto& list : activeLists)
+		list.clear();
+
+	for (auto o : gameObjects) {
+		for (int i = 0; i < ActiveListCount; ++i)
+			o->activeListSlots[i] = -1;
+		UpdateActiveLists(o);
+	}
+}
+
 bool GameWorld::Raycast(Ray& r, RayCollision& closestCollision, bool closestObject, bool includeStatic) const {
 	RayCollision collision;
 
@@ -270,7 +617,7 @@ void GameWorld::GetConstraintIterators(
 
 
 
-std::vector<GameObject*> GameWorld::ObjectsWithinRadius(Vector3 position, float radius, std::string tag) const {
+std::vector<GameObject*> GameWorld::ObjectsWithinRadius(Vector3 position, float radius, const std::string& tag) const {
 
 	typedef std::pair<float, GameObject*> DistObjectPair;
 
@@ -280,11 +627,13 @@ std::vector<GameObject*> GameWorld::ObjectsWithinRadius(Vector3 position, float
 	//objects in every comparison.
 	std::vector<DistObjectPair> foundObjects;
 
+	TagID tagID = tag.empty() ? INVALID_TAG : Tags::Find(tag);
+
 	float sqrRadius = radius * radius;
 	for (auto object : possibleObjects) {
 
 		//If a tag is defined. Only test objects with the tag.
-		if (tag == "" || !object->HasTag(tag))
+		if (!tag.empty() && !object->HasTag(tagID))
 			continue;
 
 		float sqrDist = (position - object->GetTransform().GetPosition()).LengthSquared();
@@ -3,6 +3,7 @@
 #include "CollisionDetection.h"
 #include "QuadTree.h"
 #include "GameObject.h"
+#include "WorldSnapshot.h"
 
 #include <vector>
 
@@ -24,11 +25,39 @@ namespace NCL {
 			void ClearAndErase();
 			void ForceClearAndErase();
 
-			std::vector<GameObject*> GetObjectsWithTag(std::string tag) const;
-			GameObject* GetObjectWithTag(std::string tag) const;
+			//copies the transform, activation and component state of every non persistent object
+			void CaptureSnapshot(/*OUT*/ WorldSnapshot& snapshot) const;
+			//puts every object in the snapshot back in place, deleting non persistent objects added
+			//since and components added to its objects since. Those objects start again on the next
+			//update. False, with nothing restored, if one of them has been deleted or has lost components
+			bool RestoreSnapshot(const WorldSnapshot& snapshot);
+
+			//tag lookups go through the index, so cost only depends on how many objects have the tag
+			const std::vector<GameObject*>& GetObjectsWithTag(TagID tag) const;
+			const std::vector<GameObject*>& GetObjectsWithTag(const std::string& tag) const;
+			GameObject* GetObjectWithTag(TagID tag) const;
+			GameObject* GetObjectWithTag(const std::string& tag) const;
 
 			GameObject* AddGameObject(GameObject* o);
 			void RemoveGameObject(GameObject* o, bool andDelete = false);
+			void QueueDestroy(GameObject* o);
+
+			//runs f on the main thread once this frame's component update has finished.
+			//Safe to call from thread safe component updates
+			void Defer(const std::function<void()>& f);
+
+			//nullptr if the object has since been removed from the world
+			GameObject* GetObject(GameObjectHandle handle) const {
+				if (handle.index >= handleSlots.size())
+					return nullptr;
+
+				const HandleSlot& slot = handleSlots[handle.index];
+				return slot.generation == handle.generation ? slot.object : nullptr;
+			}
+
+			const std::vector<GameObject*>& GetActiveObjects(ActiveList list) const {
+				return activeLists[list];
+			}
 
 			void AddKillPlane(Plane* p);
 			void RemoveKillPlane(Plane* p, bool andDelete = false);
@@ -54,9 +83,14 @@ namespace NCL {
 
 			bool Raycast(Ray& r, RayCollision& closestCollision, bool closestObject = false, bool includeStatic = false) const;
 
-			std::vector<GameObject*> ObjectsWithinRadius(Vector3 position, float radius, std::string tag = "") const;
+			std::vector<GameObject*> ObjectsWithinRadius(Vector3 position, float radius, const std::string& tag = "") const;
 
+			//runs UpdateSimulation then UpdateObjects. The game's frame graph calls them as separate
+			//tasks so animation can overlap with the other end of frame work
 			virtual void UpdateWorld(float dt);
+			void UpdateSimulation(float dt);
+			//advances animations and the per object update hook
+			void UpdateObjects(float dt);
 
 			void OperateOnContents(GameObjectFunc f);
 
@@ -70,16 +104,17 @@ namespace NCL {
 
 			void FlipDisplayQuadTree() { displayQuadtree = !displayQuadtree; }
 
-			//This is very costly and should not be done regularly.
+			//these walk the pool for T, so they only touch components of that type
 			template<class T>
 			std::vector<GameObject*> GetObjectsWithComponent() const {
 				static_assert(std::is_base_of<Component, T>::value, "Provided type is not a subclass of component");
 
 				std::vector<GameObject*> objects;
-				for (auto gameObject : gameObjects) {
-					if (gameObject->GetComponent<T>()) {
-						objects.push_back(gameObject);
-					}
+				for (auto component : ComponentPools::Get<T>().GetComponents()) {
+					GameObject* owner = component->GetGameObject();
+					//only count each object once if it has more than one of the type
+					if (owner->world == this && owner->GetComponent<T>() == component)
+						objects.push_back(owner);
 				}
 				return objects;
 			}
@@ -88,11 +123,10 @@ namespace NCL {
 			T* GetComponentOfType() const {
 				static_assert(std::is_base_of<Component, T>::value, "Provided type is not a subclass of component");
 
-				std::vector<T*> components;
-				for (auto gameObject : gameObjects) {
-					T* component = gameObject->GetComponent<T>();
-					if (component != nullptr)
-						return component;
+				for (auto component : ComponentPools::Get<T>().GetComponents()) {
+					GameObject* owner = component->GetGameObject();
+					if (owner->world == this && owner->GetComponent<T>() == component)
+						return static_cast<T*>(component);
 				}
 				return nullptr;
 			}
@@ -102,21 +136,53 @@ namespace NCL {
 				static_assert(std::is_base_of<Component, T>::value, "Provided type is not a subclass of component");
 
 				std::vector<T*> components;
-				for (auto gameObject : gameObjects) {
-					T* component = gameObject->GetComponent<T>();
-					if (component != nullptr)
-						components.push_back(component);
+				for (auto component : ComponentPools::Get<T>().GetComponents()) {
+					GameObject* owner = component->GetGameObject();
+					if (owner->world == this && owner->GetComponent<T>() == component)
+						components.push_back(static_cast<T*>(component));
 				}
 				return components;
 			}
 
 		protected:
 			void Clear();
+			void UpdateComponents(float dt);
+			void UpdateComponentRange(const std::vector<Component*>& components, size_t begin, size_t end, float dt);
+			void FlushDeferred();
+
+			friend class GameObject;
+			void AddToTagIndex(GameObject* o, TagID tag);
+			void RemoveFromTagIndex(GameObject* o);
+			void RebuildTagIndex();
+			void FlushDestroyQueue();
+
+			void UpdateActiveLists(GameObject* o);
+			void RebuildActiveLists();
+
+			void AllocateHandle(GameObject* o);
+			void ReleaseHandle(GameObject* o);
+			void ReleaseAllHandles();
+
+			struct HandleSlot {
+				GameObject*	 object;
+				unsigned int generation;
+			};
+			std::vector<HandleSlot> handleSlots;
+			std::vector<unsigned int> freeHandles;
+			//by handle index, which objects a snapshot being restored keeps
+			std::vector<bool> snapshotMarks;
 
 			std::vector<GameObject*> newGameObjects;
 			std::vector<GameObject*> gameObjects;
+			std::vector<GameObject*> destroyQueue;
+			std::vector<GameObject*> destroying;
+			std::vector<GameObject*> activeLists[ActiveListCount];
 			std::vector<Constraint*> constraints;
 			std::vector<Plane*>		 killPlanes;
+			//one list per job system thread so deferring never needs a lock
+			std::vector<std::vector<std::function<void()>>> deferred;
+			//objects in the world for each tag id
+			std::vector<std::vector<GameObject*>> taggedObjects;
 
 			QuadTree<GameObject*>* objectTree;
 			QuadTree<GameObject*>* staticObjectTree;
@@ -0,0 +1,198 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <iostream>
+
+using namespace NCL;
+using namespace CSC8508;
+
+unsigned int JobSystem::workerCount = 0;
+std::vector<JobSystem::Queue*> JobSystem::queues;
+std::vector<std::thread> JobSystem::workers;
+std::mutex JobSystem::sleepLock;
+std::condition_variable JobSystem::wake;
+std::atomic<int> JobSystem::queuedJobs(0);
+std::atomic<bool> JobSystem::quitting(false);
+
+namespace {
+	thread_local unsigned int threadIndex = 0;
+}
+
+void JobSystem::Init(unsigned int workers) {
+	if (!queues.empty())
+		return;
+
+	if (workers == 0) {
+		unsigned int hardwareThreads = std::thread::hardware_concurrency();
+		workers = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+	}
+
+	workerCount = workers;
+	quitting = false;
+
+	//queue 0 belongs to the main thread
+	for (unsigned int i = 0; i <= workerCount; ++i)
+		queues.push_back(new Queue());
+
+	for (unsigned int i = 1; i <= workerCount; ++i)
+		JobSystem::workers.emplace_back(&JobSystem::WorkerLoop, i);
+
+	std::cout << "Job system started with " << workerCount << " worker threads\n";
+}
+
+void JobSystem::Shutdown() {
+	{
+		std::lock_guard<std::mutex> guard(sleepLock);
+		quitting = true;
+	}
+	wake.notify_all();
+
+	for (auto& i : workers)
+		i.join();
+	workers.clear();
+
+	for (auto i : queues)
+		delete i;
+	queues.clear();
+
+	workerCount = 0;
+	queuedJobs = 0;
+}
+
+unsigned int JobSystem::GetThreadIndex() {
+	return threadIndex;
+}
+
+void JobSystem::Run(const Job& job, JobCounter* counter) {
+	if (counter)
+		counter->pending++;
+
+	if (workerCount == 0) {
+		Entry entry;
+		entry.job = job;
+		entry.counter = counter;
+		entry.tag = AllocationTracker::GetCurrentTag();
+		Execute(entry);
+		return;
+	}
+
+	Queue* queue = queues[threadIndex];
+	{
+		std::lock_guard<std::mutex> guard(queue->lock);
+		Entry entry;
+		entry.job = job;
+		entry.counter = counter;
+		entry.tag = AllocationTracker::GetCurrentTag();
+		queue->jobs.push_back(std::move(entry));
+	}
+
+	//taking the sleep lock means a worker can't miss the job between checking and sleeping
+	{
+		std::lock_guard<std::mutex> guard(sleepLock);
+		queuedJobs++;
+	}
+	wake.notify_one();
+}
+
+void JobSystem::Wait(JobCounter& counter) {
+	Entry entry;
+	while (!counter.IsDone()) {
+		if (PopOrSteal(threadIndex, entry))
+			Execute(entry);
+		else
+			std::this_thread::yield();
+	}
+}
+
+bool JobSystem::TryRunJob() {
+	Entry entry;
+	if (!PopOrSteal(threadIndex, entry))
+		return false;
+
+	Execute(entry);
+	return true;
+}
+
+void JobSystem::ParallelFor(int count, int minPerJob, const RangeJob& job) {
+	if (count <= 0)
+		return;
+
+	//a few ranges per thread so stealing can even out uneven jobs
+	int maxJobs = (int)GetThreadCount() * 4;
+	int jobCount = std::min(maxJobs, count / std::max(1, minPerJob));
+	if (workerCount == 0 || jobCount <= 1) {
+		job(0, count);
+		return;
+	}
+
+	int perJob = (count + jobCount - 1) / jobCount;
+
+	JobCounter counter;
+	for (int start = perJob; start < count; start += perJob) {
+		int end = std::min(start + perJob, count);
+		Run([&job, start, end]() { job(start, end); }, &counter);
+	}
+
+	job(0, std::min(perJob, count));
+	Wait(counter);
+}
+
+void JobSystem::WorkerLoop(unsigned int index) {
+	threadIndex = index;
+
+	Entry entry;
+	while (true) {
+		if (PopOrSteal(index, entry)) {
+			Execute(entry);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(sleepLock);
+		wake.wait(lock, []() { return queuedJobs.load() > 0 || quitting.load(); });
+		if (quitting)
+			return;
+	}
+}
+
+bool JobSystem::PopOrSteal(unsigned int index, Entry& entry) {
+	if (queues.empty())
+		return false;
+
+	//newest from our own queue, it's the most likely to still be in cache
+	{
+		Queue* own = queues[index];
+		std::lock_guard<std::mutex> guard(own->lock);
+		if (!own->jobs.empty()) {
+			entry = std::move(own->jobs.back());
+			own->jobs.pop_back();
+			queuedJobs--;
+			return true;
+		}
+	}
+
+	//oldest from everyone else, starting after ourselves so thieves spread out
+	unsigned int queueCount = (unsigned int)queues.size();
+	for (unsigned int i = 1; i < queueCount; ++i) {
+		Queue* victim = queues[(index + i) % queueCount];
+		std::lock_guard<std::mutex> guard(victim->lock);
+		if (!victim->jobs.empty()) {
+			entry = std::move(victim->jobs.front());
+			victim->jobs.pop_front();
+			queuedJobs--;
+			return true;
+		}
+	}
+	return false;
+}
+
+void JobSystem::Execute(Entry& entry) {
+	{
+		ALLOC_SCOPE(entry.tag);
+		entry.job();
+	}
+	if (entry.counter)
+		entry.counter->pending--;
+
+	entry.job = nullptr;
+	entry.counter = nullptr;
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "AllocationTracker.h"
+
+#include <functional>
+#include <atomic>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+namespace NCL {
+	namespace CSC8508 {
+
+		//counts the jobs of a batch that haven't finished yet, so the caller can wait on the batch
+		struct JobCounter {
+			std::atomic<int> pending;
+
+			JobCounter() : pending(0) {}
+			bool IsDone() const { return pending.load() == 0; }
+		};
+
+		//engine wide pool of worker threads. Every thread has its own queue: it takes its newest job
+		//first and steals the oldest job from another queue once its own is empty.
+		//A thread waiting on a counter runs queued jobs until the counter clears instead of blocking,
+		//so jobs can start and wait on jobs of their own.
+		//Until Init is called, or with no workers, jobs just run inline on the calling thread
+		class JobSystem {
+		public:
+			typedef std::function<void()> Job;
+			typedef std::function<void(int begin, int end)> RangeJob;
+
+			//0 workers picks one less than the number of hardware threads
+			static void Init(unsigned int workers = 0);
+			static void Shutdown();
+
+			static void Run(const Job& job, JobCounter* counter = nullptr);
+			static void Wait(JobCounter& counter);
+			//runs one queued job on the calling thread, false if there wasn't one
+			static bool TryRunJob();
+
+			//splits [0, count) into ranges of at least minPerJob and waits for them all.
+			//The calling thread takes a range itself
+			static void ParallelFor(int count, int minPerJob, const RangeJob& job);
+
+			static unsigned int GetWorkerCount() { return workerCount; }
+			//workers plus the main thread
+			static unsigned int GetThreadCount() { return workerCount + 1; }
+			//0 for the main thread and any thread not owned by the job system
+			static unsigned int GetThreadIndex();
+
+		private:
+			struct Entry {
+				Job job;
+				JobCounter* counter = nullptr;
+				//allocations made by the job are charged to whoever queued it
+				AllocTag tag = AllocTag::Untagged;
+			};
+
+			struct Queue {
+				std::mutex lock;
+				std::deque<Entry> jobs;
+			};
+
+			static void WorkerLoop(unsigned int index);
+			static bool PopOrSteal(unsigned int index, Entry& entry);
+			static void Execute(Entry& entry);
+
+			static unsigned int workerCount;
+			static std::vector<Queue*> queues;
+			static std::vector<std::thread> workers;
+
+			//workers sleep here while every queue is empty
+			static std::mutex sleepLock;
+			static std::condition_variable wake;
+			static std::atomic<int> queuedJobs;
+			static std::atomic<bool> quitting;
+		};
+	}
+}
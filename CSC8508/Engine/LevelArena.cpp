@@ -0,0 +1,133 @@
+#include "LevelArena.h"
+
+#include <cstdlib>
+#include <cassert>
+
+using namespace NCL::CSC8508;
+
+LevelArena* LevelArena::loading = nullptr;
+LevelArena::Stats LevelArena::lastLevelStats;
+int LevelArena::liveArenas = 0;
+size_t LevelArena::heapAllocations = 0;
+
+namespace {
+	//every allocation is preceded by a header saying where it came from. It is 16 bytes so
+	//what follows keeps the alignment bullet's SIMD types need
+	struct AllocationHeader {
+		LevelArena* arena;
+		size_t		size;
+	};
+	static_assert(sizeof(AllocationHeader) == 16 || sizeof(void*) == 4, "Allocation header must keep 16 byte alignment");
+
+	const size_t HEADER_SIZE = 16;
+	const size_t ALIGNMENT = 16;
+
+	size_t AlignUp(size_t size) {
+		return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+	}
+}
+
+LevelArena::LevelArena() {
+	blockUsed = BLOCK_SIZE;
+	liveAllocations = 0;
+	closed = false;
+	liveArenas++;
+}
+
+LevelArena::~LevelArena() {
+	for (auto block : blocks)
+		_aligned_free(block);
+
+	liveArenas--;
+}
+
+void LevelArena::BeginLevel() {
+	assert(!loading);
+	loading = new LevelArena();
+}
+
+void LevelArena::EndLevel() {
+	assert(loading);
+	LevelArena* arena = loading;
+	loading = nullptr;
+
+	lastLevelStats = arena->stats;
+	arena->closed = true;
+
+	if (arena->liveAllocations == 0)
+		delete arena;
+}
+
+void* LevelArena::Allocate(size_t size) {
+	size_t total = HEADER_SIZE + AlignUp(size);
+	char* memory;
+
+	if (loading) {
+		memory = (char*)loading->AllocateFromBlocks(total);
+	}
+	else {
+		memory = (char*)_aligned_malloc(total, ALIGNMENT);
+		heapAllocations++;
+	}
+
+	if (!memory)
+		throw std::bad_alloc();
+
+	AllocationHeader* header = (AllocationHeader*)memory;
+	header->arena = loading;
+	header->size = size;
+	return memory + HEADER_SIZE;
+}
+
+void LevelArena::Free(void* ptr) {
+	if (!ptr)
+		return;
+
+	char* memory = (char*)ptr - HEADER_SIZE;
+	AllocationHeader* header = (AllocationHeader*)memory;
+
+	if (header->arena)
+		header->arena->Release();
+	else
+		_aligned_free(memory);
+}
+
+void* LevelArena::AllocateFromBlocks(size_t size) {
+	std::lock_guard<std::mutex> guard(lock);
+	char* memory;
+
+	if (size > BLOCK_SIZE) {
+		//anything too big for a block gets one of its own, the current block carries on after it
+		memory = (char*)_aligned_malloc(size, ALIGNMENT);
+		blocks.insert(blocks.begin(), memory);
+		stats.blocks++;
+	}
+	else {
+		if (blockUsed + size > BLOCK_SIZE) {
+			blocks.push_back((char*)_aligned_malloc(BLOCK_SIZE, ALIGNMENT));
+			blockUsed = 0;
+			stats.blocks++;
+		}
+		memory = blocks.back() + blockUsed;
+		blockUsed += size;
+	}
+
+	liveAllocations++;
+	stats.allocations++;
+	stats.bytes += size;
+	return memory;
+}
+
+//memory is only given back once everything in the arena has been freed
+void LevelArena::Release() {
+	bool unused;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		assert(liveAllocations > 0);
+		liveAllocations--;
+		unused = liveAllocations == 0 && closed;
+	}
+
+	if (unused)
+		delete this;
+}
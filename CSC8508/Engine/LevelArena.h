@@ -0,0 +1,91 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <utility>
+#include <new>
+#include <mutex>
+
+namespace NCL {
+	namespace CSC8508 {
+
+		//bump allocator for everything a level creates while it loads. Allocations are carved out of
+		//large blocks and never freed individually, the blocks are all released together once the
+		//last object from the level has been deleted. Loading allocates from worker threads too, so
+		//each arena is locked.
+		//Anything allocated while no level is loading comes from the normal heap, so objects created
+		//during play and persistent objects don't keep an arena alive
+		class LevelArena {
+		public:
+			struct Stats {
+				size_t allocations = 0;
+				size_t bytes = 0;
+				size_t blocks = 0;
+			};
+
+			//allocations from here until EndLevel go into a new arena
+			static void BeginLevel();
+			static void EndLevel();
+
+			static void* Allocate(size_t size);
+			static void Free(void* ptr);
+
+			static bool IsLoading() { return loading != nullptr; }
+			//stats for the arena of the last level loaded
+			static const Stats& GetLastLevelStats() { return lastLevelStats; }
+			//number of arenas still waiting for their objects to be deleted
+			static int GetLiveArenaCount() { return liveArenas; }
+			static size_t GetHeapAllocationCount() { return heapAllocations; }
+
+		private:
+			LevelArena();
+			~LevelArena();
+
+			void* AllocateFromBlocks(size_t size);
+			void Release();
+
+			static const size_t BLOCK_SIZE = 1024 * 1024;
+
+			std::vector<char*> blocks;
+			size_t blockUsed;
+			size_t liveAllocations;
+			bool closed;
+			Stats stats;
+			std::mutex lock;
+
+			static LevelArena* loading;
+			static Stats lastLevelStats;
+			static int liveArenas;
+			static size_t heapAllocations;
+		};
+
+		//loads a level between construction and destruction, so a load that throws still ends the level
+		class LevelArenaScope {
+		public:
+			LevelArenaScope() { LevelArena::BeginLevel(); }
+			~LevelArenaScope() { LevelArena::EndLevel(); }
+
+			LevelArenaScope(const LevelArenaScope&) = delete;
+			LevelArenaScope& operator=(const LevelArenaScope&) = delete;
+		};
+
+		//classes that derive from this are placed in the loading level's arena when created during a load
+		struct ArenaAllocated {
+			static void* operator new(size_t size) { return LevelArena::Allocate(size); }
+			static void operator delete(void* ptr) { LevelArena::Free(ptr); }
+		};
+
+		//for types that can't derive from ArenaAllocated, such as bullet's
+		template<typename T, typename... Params>
+		T* ArenaNew(Params&&... vals) {
+			return new (LevelArena::Allocate(sizeof(T))) T(std::forward<Params>(vals)...);
+		}
+
+		template<typename T>
+		void ArenaDelete(T* ptr) {
+			if (!ptr)
+				return;
+			ptr->~T();
+			LevelArena::Free(ptr);
+		}
+	}
+}
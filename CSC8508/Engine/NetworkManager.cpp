@@ -1,5 +1,7 @@
 #include "NetworkManager.h"
 #include "../../Common/Window.h"
+#include "Profiler.h"
+#include "AllocationTracker.h"
 
 using namespace NCL;
 using namespace CSC8508;
@@ -44,6 +46,8 @@ NetworkManager::~NetworkManager()
 void NetworkManager::Update(float dt)
 {
 	if (OFFLINE_MODE) return;
+	PROFILE_SCOPE("NetworkManager::Update");
+	ALLOC_SCOPE(AllocTag::Network);
 	timeToNextPacket -= dt;
 
 	if (timeToNextPacket < 0) {
@@ -131,7 +135,7 @@ bool NCL::CSC8508::NetworkManager::IsAllPlayersFinished()
 	NetworkPlayerComponent* npc;
 	for (auto i = serverPlayers.begin(); i != serverPlayers.end(); ++i) {
 		npc = i->second->GetNetworkPlayerComponent();
-		if (!npc->isFinished()) return false;
+		if (npc && !npc->isFinished()) return false;
 
 	}
 
@@ -212,9 +216,10 @@ void NCL::CSC8508::NetworkManager::UpdateLocalPlayer(float dt)
 {
 	GamePacket* newPacket;
 
-	localPlayer->player->WritePacket(&newPacket, dt, stateID);
-	thisClient->SendPacket(*newPacket);
-	delete newPacket;
+	if (localPlayer->player->WritePacket(&newPacket, dt, stateID)) {
+		thisClient->SendPacket(*newPacket);
+		delete newPacket;
+	}
 
 	newPacket = new PlayerStatusPacket(localPlayer->player->GetPlayerID(), localPlayer->score, localPlayer->isFinished);
 	thisClient->SendPacket(*newPacket);
@@ -226,9 +231,10 @@ void NCL::CSC8508::NetworkManager::BroadcastSnapshot(bool deltaFrame)
 {
 	for (int i = 0; i < serverPlayers.size(); i++) {
 		GamePacket* newPacket;
-		serverPlayers.at(i)->WritePacket(&newPacket, deltaFrame, stateID);
-		thisServer->SendGlobalPacket(*newPacket);
-		delete newPacket;
+		if (serverPlayers.at(i)->WritePacket(&newPacket, deltaFrame, stateID)) {
+			thisServer->SendGlobalPacket(*newPacket);
+			delete newPacket;
+		}
 
 		NetworkPlayerComponent* player = serverPlayers.at(i)->GetNetworkPlayerComponent();
 
@@ -258,7 +264,7 @@ int NCL::CSC8508::NetworkManager::GetNoOfPlayersFinished() const
 	NetworkPlayerComponent* npc;
 	for (auto i = serverPlayers.begin(); i != serverPlayers.end(); ++i) {
 		npc = i->second->GetNetworkPlayerComponent();
-		if (npc->isFinished()) noOfPlayers++;
+		if (npc && npc->isFinished()) noOfPlayers++;
 	}
 
 	if (isClient)
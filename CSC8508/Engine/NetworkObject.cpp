@@ -1,10 +1,11 @@
 #include "NetworkObject.h"
+#include "GameWorld.h"
 #include "../Game/NetworkPlayerComponent.h"
 
 using namespace NCL;
 using namespace CSC8508;
 
-NetworkObject::NetworkObject(GameObject& o, int id) : object(o)	{
+NetworkObject::NetworkObject(GameObject& o, int id) : objectHandle(o.GetHandle()), world(o.GetWorld())	{
 	deltaErrors = 0;
 	fullErrors  = 0;
 	networkID   = id;
@@ -13,6 +14,10 @@ NetworkObject::NetworkObject(GameObject& o, int id) : object(o)	{
 NetworkObject::~NetworkObject()	{
 }
 
+GameObject* NetworkObject::GetObject() const {
+	return world ? world->GetObject(objectHandle) : nullptr;
+}
+
 bool NetworkObject::ReadPacket(GamePacket& p) {
 	if (p.type == Player_Delta_State) {
 		return ReadDeltaPacket((DeltaPacket&)p);
@@ -40,6 +45,10 @@ bool NetworkObject::WritePacket(GamePacket** p, bool deltaFrame, int stateID) {
 }
 //Client objects recieve these packets
 bool NetworkObject::ReadDeltaPacket(DeltaPacket &p) {
+	GameObject* object = GetObject();
+	if (!object) {
+		return false;
+	}
 	if (p.fullID != lastFullState.stateID) {
 		deltaErrors++; //can't delta this frame
 		return false;
@@ -50,7 +59,7 @@ bool NetworkObject::ReadDeltaPacket(DeltaPacket &p) {
 	Vector3		fullPos			= lastFullState.position;
 	Quaternion  fullOrientation = lastFullState.orientation;
 
-	auto networkPlayer = object.GetComponent<NetworkPlayerComponent>();
+	auto networkPlayer = object->GetComponent<NetworkPlayerComponent>();
 	networkPlayer->SetTargetPosition(fullPos);
 	networkPlayer->SetOrientation(fullOrientation);
 
@@ -71,9 +80,13 @@ bool NetworkObject::ReadFullPacket(FullPacket &p) {
 	//if (p.fullState.stateID < lastFullState.stateID) {
 //		return false; // received an 'old' packet, ignore!
 //	}
+	GameObject* object = GetObject();
+	if (!object) {
+		return false;
+	}
 	lastFullState = p.fullState;
 
-	auto networkPlayer = object.GetComponent<NetworkPlayerComponent>();
+	auto networkPlayer = object->GetComponent<NetworkPlayerComponent>();
 	networkPlayer->SetTargetPosition(lastFullState.position);
 	networkPlayer->SetOrientation(lastFullState.orientation);
 
@@ -91,6 +104,11 @@ bool NCL::CSC8508::NetworkObject::ReadPlayerFinishedPacket(PlayerFinishedPacket&
 }
 
 bool NetworkObject::WriteDeltaPacket(GamePacket**p, int stateID) {
+	GameObject* object = GetObject();
+	if (!object) {
+		return false;
+	}
+
 	DeltaPacket* dp = new DeltaPacket();
 
 	dp->objectID = networkID;
@@ -102,8 +120,8 @@ bool NetworkObject::WriteDeltaPacket(GamePacket**p, int stateID) {
 
 	dp->fullID = stateID;
 
-	Vector3		currentPos			= object.GetTransform().GetPosition();
-	Quaternion  currentOrientation  = object.GetTransform().GetOrientation();
+	Vector3		currentPos			= object->GetTransform().GetPosition();
+	Quaternion  currentOrientation  = object->GetTransform().GetOrientation();
 
 	currentPos			-= state.position;
 	currentOrientation  -= state.orientation;
@@ -122,11 +140,16 @@ bool NetworkObject::WriteDeltaPacket(GamePacket**p, int stateID) {
 }
 
 bool NetworkObject::WriteFullPacket(GamePacket**p) {
+	GameObject* object = GetObject();
+	if (!object) {
+		return false;
+	}
+
 	FullPacket* fp = new FullPacket();
 
 	fp->objectID				= networkID;
-	fp->fullState.position		= object.GetTransform().GetPosition();
-	fp->fullState.orientation	= object.GetTransform().GetOrientation();
+	fp->fullState.position		= object->GetTransform().GetPosition();
+	fp->fullState.orientation	= object->GetTransform().GetOrientation();
 	fp->fullState.stateID		= lastFullState.stateID++;
 
 	*p = fp;
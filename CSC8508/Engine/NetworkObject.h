@@ -1,5 +1,6 @@
 #pragma once
 #include "GameObject.h"
+#include "GameObjectHandle.h"
 #include "NetworkBase.h"
 #include "NetworkState.h"
 namespace NCL {
@@ -72,6 +73,9 @@ namespace NCL {
 			virtual void Update(GamePacket& p);
 			void UpdateStateHistory(int minID);
 
+			//null once the object has left the world
+			GameObject* GetObject() const;
+
 		protected:
 
 			NetworkState& GetLatestNetworkState();
@@ -94,7 +98,8 @@ namespace NCL {
 			int deltaErrors;
 			int fullErrors;
 
-			GameObject& object;
+			GameObjectHandle objectHandle;
+			GameWorld* world;
 			Quaternion orientation;
 
 			int networkID;
@@ -1,4 +1,8 @@
 #include "BulletWorld.h"
+#include "../../CSC8508/Engine/GameWorld.h"
+#include "../../CSC8508/Engine/JobSystem.h"
+#include "../../CSC8508/Engine/Profiler.h"
+#include "../../CSC8508/Engine/AllocationTracker.h"
 #include <algorithm>
 
 
@@ -11,37 +15,84 @@ BulletWorld::BulletWorld()
 {
 	//creates the bulletworld wwith default parameters
 	collisionConfiguration = new btDefaultCollisionConfiguration();
-	dispatcher = new btCollisionDispatcher(collisionConfiguration);
-	overlappingPairCache = new btDbvtBroadphase();
-	solver = new btSequentialImpulseConstraintSolver;
-	dynamicsWorld = new btDiscreteDynamicsWorld(dispatcher, overlappingPairCache, solver, collisionConfiguration);
-	dynamicsWorld->setGravity(btVector3(0, -20.0f, 0));
-	dynamicsWorld->setInternalTickCallback((btInternalTickCallback)tickCallBack, this, true);
+	gravity = btVector3(0, -20.0f, 0);
+	createDynamicsWorld();
 }
 
 BulletWorld::~BulletWorld()
 {
-	delete dynamicsWorld;
-	delete solver;
-	delete overlappingPairCache;
-	delete dispatcher;
-	delete collisionConfiguration;
-
 	for (auto i : constraintList)
 	{
 		dynamicsWorld->removeConstraint(i);
 		delete i;
 	}
 
+	destroyDynamicsWorld();
+	delete collisionConfiguration;
+
+	for (auto i : bodyTable)
+		if (i)
+			i->detachFromWorld();
+
 	contactList.clear();
+	triggerPairs.clear();
+	triggerList.clear();
 	rigidList.clear();
-	contactList.clear();
+	bodyTable.clear();
+	constraintList.clear();
+}
+
+//builds the dispatcher, broadphase, solver and world. Kept separate so clear() can throw
+//the whole world away in one go rather than removing bodies one at a time
+void BulletWorld::createDynamicsWorld()
+{
+	dispatcher = new btCollisionDispatcher(collisionConfiguration);
+	dispatcher->setNearCallback(nearCallBack);
+	overlappingPairCache = new btDbvtBroadphase();
+	ghostPairCallback = new btGhostPairCallback();
+	overlappingPairCache->getOverlappingPairCache()->setInternalGhostPairCallback(ghostPairCallback);
+	solver = new btSequentialImpulseConstraintSolver;
+	dynamicsWorld = new btDiscreteDynamicsWorld(dispatcher, overlappingPairCache, solver, collisionConfiguration);
+	dynamicsWorld->setGravity(gravity);
+	dynamicsWorld->setLatencyMotionStateInterpolation(true);
+	dynamicsWorld->setInternalTickCallback((btInternalTickCallback)tickCallBack, this, true);
+}
+
+void BulletWorld::destroyDynamicsWorld()
+{
+	//drop every pair from the back first so destroying each proxy afterwards doesn't have to
+	//search the pair cache, which is what made removing bodies one by one quadratic
+	btOverlappingPairCache* pairCache = overlappingPairCache->getOverlappingPairCache();
+	btBroadphasePairArray& pairs = pairCache->getOverlappingPairArray();
+	while (pairs.size() > 0)
+	{
+		btBroadphasePair& pair = pairs[pairs.size() - 1];
+		pairCache->removeOverlappingPair(pair.m_pProxy0, pair.m_pProxy1, dispatcher);
+	}
+
+	btCollisionObjectArray& objects = dynamicsWorld->getCollisionObjectArray();
+	for (int i = 0; i < objects.size(); i++)
+	{
+		btBroadphaseProxy* proxy = objects[i]->getBroadphaseHandle();
+		if (proxy)
+		{
+			overlappingPairCache->destroyProxy(proxy, dispatcher);
+			objects[i]->setBroadphaseHandle(nullptr);
+		}
+	}
+
+	delete dynamicsWorld;
+	delete solver;
+	delete overlappingPairCache;
+	delete ghostPairCallback;
+	delete dispatcher;
 }
 
 //sets gravity
 void BulletWorld::setGravity(NCL::Maths::Vector3 force)
 {
-	dynamicsWorld->setGravity(convertVector3(force));
+	gravity = convertVector3(force);
+	dynamicsWorld->setGravity(gravity);
 }
 
 void BulletWorld::addpointconstraint(RigidBody* bodyA, NCL::Maths::Vector3 point) 
@@ -69,6 +120,7 @@ GameObject* BulletWorld::rayIntersect(NCL::Maths::Vector3 from, NCL::Maths::Vect
 	btVector3 btFrom = convertVector3(from);
 	btVector3 btTo = convertVector3(to);
 	btCollisionWorld::ClosestRayResultCallback res(btFrom, btTo);
+	res.m_collisionFilterMask = btBroadphaseProxy::AllFilter ^ btBroadphaseProxy::SensorTrigger;
 	dynamicsWorld->rayTest(btFrom, btTo, res);
 	if (res.hasHit())
 	{
@@ -78,29 +130,316 @@ GameObject* BulletWorld::rayIntersect(NCL::Maths::Vector3 from, NCL::Maths::Vect
 	return nullptr;
 }
 
+namespace
+{
+	//tests one ray against each proxy the dbvt finds along it
+	struct RayLeafCallback : public btDbvt::ICollide
+	{
+		btTransform fromTrans;
+		btTransform toTrans;
+		btCollisionWorld::ClosestRayResultCallback* result;
+
+		void Process(const btDbvtNode* leaf)
+		{
+			btCollisionObject* obj = (btCollisionObject*)((btDbvtProxy*)leaf->data)->m_clientObject;
+
+			//same filtering as a regular ray test, so disabled bodies and triggers are skipped
+			if (!result->needsCollision(obj->getBroadphaseHandle()))
+				return;
+
+			btCollisionWorld::rayTestSingle(fromTrans, toTrans, obj, obj->getCollisionShape(), obj->getWorldTransform(), *result);
+		}
+	};
+
+	//rays below this count aren't worth handing to another thread
+	const int MIN_RAYS_PER_WORKER = 8;
+}
+
+//casts many rays at once, optionally split across job system threads. Each ray walks the broadphase
+//trees on its own, so rays spread over the level don't share one huge set of candidates.
+//hits has one entry per ray in the same order
+void BulletWorld::rayIntersectBatch(const std::vector<RayQuery>& rays, /*OUT*/ std::vector<RayHit>& hits, int workerCount)
+{
+	hits.assign(rays.size(), RayHit());
+	if (rays.empty())
+		return;
+
+	int rayCount = (int)rays.size();
+	workerCount = std::max(1, std::min(workerCount, rayCount / MIN_RAYS_PER_WORKER));
+	if (workerCount == 1)
+	{
+		castRayRange(rays, hits, 0, rayCount);
+		return;
+	}
+
+	//each job writes a separate range of hits so they don't need to share anything
+	int perWorker = (rayCount + workerCount - 1) / workerCount;
+	JobSystem::ParallelFor(rayCount, perWorker, [&](int begin, int end)
+	{
+		castRayRange(rays, hits, begin, end);
+	});
+}
+
+//walks the dbvt trees directly rather than through btDbvtBroadphase::rayTest, which shares one
+//traversal stack and so can't be called from several threads at once
+void BulletWorld::castRayRange(const std::vector<RayQuery>& rays, std::vector<RayHit>& hits, int start, int end) const
+{
+	for (int i = start; i < end; i++)
+	{
+		btVector3 from = convertVector3(rays[i].from);
+		btVector3 to = convertVector3(rays[i].to);
+		btCollisionWorld::ClosestRayResultCallback res(from, to);
+		res.m_collisionFilterMask = btBroadphaseProxy::AllFilter ^ btBroadphaseProxy::SensorTrigger;
+
+		RayLeafCallback leafCallback;
+		leafCallback.fromTrans = btTransform(btQuaternion::getIdentity(), from);
+		leafCallback.toTrans = btTransform(btQuaternion::getIdentity(), to);
+		leafCallback.result = &res;
+
+		//set 0 holds moving proxies, set 1 the ones that have settled
+		btDbvt::rayTest(overlappingPairCache->m_sets[0].m_root, from, to, leafCallback);
+		btDbvt::rayTest(overlappingPairCache->m_sets[1].m_root, from, to, leafCallback);
+
+		if (res.hasHit())
+		{
+			hits[i].object = (GameObject*)res.m_collisionObject->getUserPointer();
+			hits[i].handle = hits[i].object->GetHandle();
+			hits[i].point = convertbtVector3(res.m_hitPointWorld);
+			hits[i].normal = convertbtVector3(res.m_hitNormalWorld);
+			hits[i].fraction = (float)res.m_closestHitFraction;
+		}
+	}
+}
+
+int BulletWorld::queueRay(NCL::Maths::Vector3 from, NCL::Maths::Vector3 to)
+{
+	RayQuery ray;
+	ray.from = from;
+	ray.to = to;
+	queuedRays.push_back(ray);
+	return (int)queuedRays.size() - 1;
+}
+
+RayHit BulletWorld::getQueuedRayHit(int ticket) const
+{
+	if (ticket < 0 || ticket >= (int)queuedRayHits.size())
+		return RayHit();
+
+	//the hit was found last step, the object may have been deleted since
+	RayHit hit = queuedRayHits[ticket];
+	if (hit.object)
+		hit.object = resolve(hit.handle);
+	return hit;
+}
+
 //adds a rigidbody to the simulation
 void BulletWorld::addRigidBody(RigidBody* body)
 {
+	if (body->isInWorld())
+		return;
+
+	if (body->bodyID == -1)
+	{
+		body->bodyID = (int)bodyTable.size();
+		bodyTable.push_back(body);
+	}
+
+	if (body->isTrigger())
+	{
+		//triggers don't need to see static geometry
+		dynamicsWorld->addCollisionObject(body->returnCollisionObject(), btBroadphaseProxy::SensorTrigger,
+			btBroadphaseProxy::AllFilter ^ btBroadphaseProxy::StaticFilter);
+		body->worldIndex = (int)triggerList.size();
+		triggerList.push_back(body);
+		return;
+	}
+
 	dynamicsWorld->addRigidBody(body->returnBody());
+	body->worldIndex = (int)rigidList.size();
 	rigidList.push_back(body);
 }
 
 //removes rigid body must be called before deleting a game object to remove the associatd body from the sim
+//the last body is swapped into the freed slot so this doesnt search the list
 void BulletWorld::removeRigidBody(RigidBody* body)
 {
-	dynamicsWorld->removeRigidBody(body->returnBody());
-	rigidList.erase(std::remove(rigidList.begin(), rigidList.end(), body), rigidList.end());
+	if (!body->isInWorld())
+		return;
+
+	std::vector<RigidBody*>& list = body->isTrigger() ? triggerList : rigidList;
+
+	if (body->isTrigger())
+		dynamicsWorld->removeCollisionObject(body->returnCollisionObject());
+	else
+		dynamicsWorld->removeRigidBody(body->returnBody());
+
+	RigidBody* last = list.back();
+	list[body->worldIndex] = last;
+	last->worldIndex = body->worldIndex;
+	list.pop_back();
+
+	body->worldIndex = -1;
+}
+
+//called when a body is deleted so the world forgets it entirely
+void BulletWorld::unregisterBody(RigidBody* body)
+{
+	removeRigidBody(body);
+	bodyTable[body->bodyID] = nullptr;
+	body->bodyID = -1;
+}
+
+//turns a body on or off without taking it out of the broadphase. A disabled body has its
+//collision filter cleared so it gets no new pairs or ray hits, and its simulation is switched off
+void BulletWorld::setBodyEnabled(RigidBody* body, bool enabled)
+{
+	btCollisionObject* rb = body->returnCollisionObject();
+	btBroadphaseProxy* proxy = rb->getBroadphaseHandle();
+
+	if (!body->isInWorld() || !proxy)
+		return;
+
+	if (!enabled)
+	{
+		body->savedFilterGroup = proxy->m_collisionFilterGroup;
+		body->savedFilterMask = proxy->m_collisionFilterMask;
+		body->savedActivationState = rb->getActivationState();
+
+		proxy->m_collisionFilterGroup = 0;
+		proxy->m_collisionFilterMask = 0;
+		overlappingPairCache->getOverlappingPairCache()->removeOverlappingPairsContainingProxy(proxy, dispatcher);
+		rb->forceActivationState(DISABLE_SIMULATION);
+	}
+	else
+	{
+		proxy->m_collisionFilterGroup = body->savedFilterGroup;
+		proxy->m_collisionFilterMask = body->savedFilterMask;
+		rb->forceActivationState(body->savedActivationState);
+		rb->activate(true);
+		dynamicsWorld->updateSingleAabb(rb);
+	}
 }
 
-//steps simulation and sets the transform based on bullet physics
+//steps simulation at a fixed rate and sets the transform based on bullet physics
+//the simulation transform is the state after the last fixed step, the render transform
+//is interpolated by bullet between the last two steps so rendering can run at any rate
 void BulletWorld::Update(float dt)
 {
-	dynamicsWorld->stepSimulation((btScalar)dt, 10);
-	for (auto i : rigidList)
+	PROFILE_SCOPE("BulletWorld::Update");
+	ALLOC_SCOPE(AllocTag::Physics);
+	{
+		PROFILE_SCOPE("Physics::Step");
+		dynamicsWorld->stepSimulation((btScalar)dt, MAX_SUB_STEPS, (btScalar)fixedTimeStep);
+	}
+	{
+		PROFILE_SCOPE("Physics::SyncTransforms");
+		for (auto i : rigidList)
+		{
+			if (!i->isEnabled())
+				continue;
+
+			i->returnBody()->applyDamping((btScalar)dt);
+			i->updateTransform();
+			i->updateRenderTransform();
+		}
+	}
+
+	PROFILE_SCOPE("Physics::RayBatch");
+	rayIntersectBatch(queuedRays, queuedRayHits, JobSystem::GetThreadCount());
+	queuedRays.clear();
+}
+
+//only ghost objects are ever paired with triggers, so their pairs skip the narrowphase entirely
+void BulletWorld::nearCallBack(btBroadphasePair& collisionPair, btCollisionDispatcher& dispatcher, const btDispatcherInfo& dispatchInfo)
+{
+	const btCollisionObject* obA = (btCollisionObject*)collisionPair.m_pProxy0->m_clientObject;
+	const btCollisionObject* obB = (btCollisionObject*)collisionPair.m_pProxy1->m_clientObject;
+
+	if (obA->getInternalType() == btCollisionObject::CO_GHOST_OBJECT || obB->getInternalType() == btCollisionObject::CO_GHOST_OBJECT)
+		return;
+
+	btCollisionDispatcher::defaultNearCallback(collisionPair, dispatcher, dispatchInfo);
+}
+
+namespace
+{
+	//only cares whether the two shapes actually touch, not about the contact points
+	struct TriggerOverlapCallback : public btCollisionWorld::ContactResultCallback
+	{
+		bool overlapping = false;
+
+		btScalar addSingleResult(btManifoldPoint& cp, const btCollisionObjectWrapper* colObj0Wrap, int partId0, int index0,
+			const btCollisionObjectWrapper* colObj1Wrap, int partId1, int index1) override
+		{
+			if (cp.getDistance() <= 0)
+				overlapping = true;
+			return 0;
+		}
+	};
+}
+
+//the broadphase keeps each ghost's list of overlapping objects up to date, those few candidates
+//get an exact shape test and the result is compared with the last step to find enter and exit events
+void BulletWorld::checkTriggers()
+{
+	currentTriggerPairs.clear();
+
+	for (auto trigger : triggerList)
+	{
+		if (!trigger->isEnabled())
+			continue;
+
+		btGhostObject* ghost = trigger->ghost;
+		for (int i = 0; i < ghost->getNumOverlappingObjects(); i++)
+		{
+			btCollisionObject* other = ghost->getOverlappingObject(i);
+
+			TriggerOverlapCallback overlap;
+			dynamicsWorld->contactPairTest(ghost, other, overlap);
+			if (overlap.overlapping)
+				currentTriggerPairs.push_back(makeRecord(ghost, other));
+		}
+	}
+
+	std::sort(currentTriggerPairs.begin(), currentTriggerPairs.end());
+
+	size_t oldIndex = 0;
+	size_t newIndex = 0;
+	while (oldIndex < triggerPairs.size() || newIndex < currentTriggerPairs.size())
 	{
-		i->returnBody()->applyDamping((btScalar)dt);
-		i->updateTransform();
-	}	
+		bool entered = oldIndex == triggerPairs.size() ||
+			(newIndex < currentTriggerPairs.size() && currentTriggerPairs[newIndex] < triggerPairs[oldIndex]);
+		bool exited = !entered && (newIndex == currentTriggerPairs.size() || triggerPairs[oldIndex] < currentTriggerPairs[newIndex]);
+
+		if (entered)
+		{
+			const collisionPair& pair = currentTriggerPairs[newIndex].objects;
+			GameObject* triggerObject = (GameObject*)pair.first->getUserPointer();
+			GameObject* otherObject = (GameObject*)pair.second->getUserPointer();
+			triggerObject->OnTriggerEnter(otherObject);
+			otherObject->OnTriggerEnter(triggerObject);
+			newIndex++;
+		}
+		else if (exited)
+		{
+			//old pairs may point at objects deleted since last step, so go through the handles
+			GameObject* triggerObject = resolve(triggerPairs[oldIndex].handleA);
+			GameObject* otherObject = resolve(triggerPairs[oldIndex].handleB);
+			if (triggerObject && otherObject)
+			{
+				triggerObject->OnTriggerExit(otherObject);
+				otherObject->OnTriggerExit(triggerObject);
+			}
+			oldIndex++;
+		}
+		else
+		{
+			oldIndex++;
+			newIndex++;
+		}
+	}
+
+	triggerPairs.swap(currentTriggerPairs);
 }
 
 //checks all manifolds for new and expired manifolds to activate the Oncollision end and begin functions
@@ -116,7 +455,7 @@ void BulletWorld::checkCollisions()
 			const btCollisionObject* obB = contactManifold->getBody1();
 
 			bool inList = false;
-			collisionPair compare = std::make_pair(obA, obB);
+			contactRecord compare = makeRecord(obA, obB);
 
 			for (auto const& j : contactList)
 				if (j == compare)
@@ -134,58 +473,197 @@ void BulletWorld::checkCollisions()
 		}
 
 	}
-	for (int j = 0; j < contactList.size(); j++)
+	for (int j = 0; j < (int)contactList.size(); j++)
 	{
 		bool inList = false;
 		for (int i = 0; i < numManifolds; i++)
 		{
 			btPersistentManifold* contactManifold = dynamicsWorld->getDispatcher()->getManifoldByIndexInternal(i);
-			const btCollisionObject* obA = contactManifold->getBody0();
-			const btCollisionObject* obB = contactManifold->getBody1();
-			collisionPair compare = std::make_pair(obA, obB);
+			contactRecord compare = makeRecord(contactManifold->getBody0(), contactManifold->getBody1());
 
 			if (contactList[j] == compare)
 				inList = true;
 		}
 		if (!inList)
 		{
-			const btCollisionObject* obA = contactList[j].first;
-			const btCollisionObject* obB = contactList[j].second;
-			((GameObject*)obA->getUserPointer())->OnCollisionEnd(((GameObject*)obB->getUserPointer()));
-			((GameObject*)obB->getUserPointer())->OnCollisionEnd(((GameObject*)obA->getUserPointer()));
+			//either object may have been deleted since the contact began
+			GameObject* objectA = resolve(contactList[j].handleA);
+			GameObject* objectB = resolve(contactList[j].handleB);
+			if (objectA && objectB)
+			{
+				objectA->OnCollisionEnd(objectB);
+				objectB->OnCollisionEnd(objectA);
+			}
 			contactList.erase(contactList.begin() + j);
+			j--;
 		}
 	}
 
 }
 
-//remove rigidbodies form the dynamics world and clear our lists so that we can repopulate the world
-//might need to create the dynamics world again need to test properly. Alternativly meta data in the 
-//dispatcher etc may need to be reset manually here
+GameObject* BulletWorld::resolve(GameObjectHandle handle) const
+{
+	return gameWorld ? gameWorld->GetObject(handle) : nullptr;
+}
+
+contactRecord BulletWorld::makeRecord(const btCollisionObject* obA, const btCollisionObject* obB) const
+{
+	contactRecord record;
+	record.objects = std::make_pair(obA, obB);
+	record.handleA = ((GameObject*)obA->getUserPointer())->GetHandle();
+	record.handleB = ((GameObject*)obB->getUserPointer())->GetHandle();
+	return record;
+}
+
+//tears the whole dynamics world down in one pass and builds an empty one, rather than removing
+//every body through the broadphase. Bodies that are still alive (persistent objects) are detached
+//and get added back to the new world when they are next activated
 void BulletWorld::clear()
 {
 	for (auto i : constraintList)
+	{
 		dynamicsWorld->removeConstraint(i);
+		delete i;
+	}
 
-	for (auto i : rigidList)
-		removeRigidBody(i);
+	destroyDynamicsWorld();
+	createDynamicsWorld();
+
+	for (auto i : bodyTable)
+		if (i)
+			i->detachFromWorld();
 
 	rigidList.clear();
+	triggerList.clear();
+	bodyTable.clear();
 	contactList.clear();
+	triggerPairs.clear();
+	stepCount = 0;
 	constraintList.clear();
+	queuedRays.clear();
+	queuedRayHits.clear();
 }
 
 //callback tests
 void BulletWorld::tickCallBack(btDynamicsWorld* world, btScalar timeStep)
 {
 	BulletWorld* worldRef = (BulletWorld*)world->getWorldUserInfo();
+	worldRef->stepCount++;
 	worldRef->updateObjects(timeStep);
 }
 
 void BulletWorld::updateObjects(float dt)
 {
+	PROFILE_SCOPE("Physics::FixedUpdate");
 	for (auto i : rigidList)
-		((GameObject*)i->returnBody()->getUserPointer())->fixedUpdate(dt);
+		if (i->isEnabled())
+			((GameObject*)i->returnBody()->getUserPointer())->fixedUpdate(dt);
+	for (auto i : triggerList)
+		if (i->isEnabled())
+			((GameObject*)i->returnBody()->getUserPointer())->fixedUpdate(dt);
 	
 	checkCollisions();
-}
\ No newline at end of file
+	checkTriggers();
+}
+//copies the state of every registered body, including ones currently removed or disabled
+void BulletWorld::captureSnapshot(/*OUT*/ PhysicsSnapshot& snapshot) const
+{
+	snapshot.step = stepCount;
+	snapshot.bodies.clear();
+	snapshot.bodies.reserve(bodyTable.size());
+
+	for (auto i : bodyTable)
+	{
+		if (!i)
+			continue;
+
+		btCollisionObject* obj = i->returnCollisionObject();
+		const btTransform& trans = obj->getWorldTransform();
+		btQuaternion rotation = trans.getRotation();
+
+		BodySnapshot state;
+		state.bodyID = i->bodyID;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			state.position[axis] = (float)trans.getOrigin()[axis];
+			state.linearVelocity[axis] = (float)i->body->getLinearVelocity()[axis];
+			state.angularVelocity[axis] = (float)i->body->getAngularVelocity()[axis];
+		}
+		state.orientation[0] = (float)rotation.x();
+		state.orientation[1] = (float)rotation.y();
+		state.orientation[2] = (float)rotation.z();
+		state.orientation[3] = (float)rotation.w();
+		//disabled bodies sit in DISABLE_SIMULATION, the state they go back to is the saved one
+		state.activationState = i->isEnabled() ? obj->getActivationState() : i->savedActivationState;
+		state.inWorld = i->isInWorld() ? 1 : 0;
+		state.enabled = i->isEnabled() ? 1 : 0;
+
+		snapshot.bodies.push_back(state);
+	}
+}
+
+//puts every body in the snapshot back in place. Bodies deleted since the capture are skipped,
+//bodies created since are left alone
+void BulletWorld::restoreSnapshot(const PhysicsSnapshot& snapshot)
+{
+	for (auto const& state : snapshot.bodies)
+	{
+		if (state.bodyID < 0 || state.bodyID >= (int)bodyTable.size() || !bodyTable[state.bodyID])
+			continue;
+
+		RigidBody* body = bodyTable[state.bodyID];
+		btCollisionObject* obj = body->returnCollisionObject();
+
+		if (state.inWorld && !body->isInWorld())
+			addRigidBody(body);
+		else if (!state.inWorld && body->isInWorld())
+			removeRigidBody(body);
+
+		btTransform trans(btQuaternion(state.orientation[0], state.orientation[1], state.orientation[2], state.orientation[3]),
+			btVector3(state.position[0], state.position[1], state.position[2]));
+		btVector3 linearVelocity(state.linearVelocity[0], state.linearVelocity[1], state.linearVelocity[2]);
+		btVector3 angularVelocity(state.angularVelocity[0], state.angularVelocity[1], state.angularVelocity[2]);
+
+		obj->setWorldTransform(trans);
+		obj->setInterpolationWorldTransform(trans);
+
+		btRigidBody* rb = body->body;
+		rb->setWorldTransform(trans);
+		rb->setInterpolationWorldTransform(trans);
+		rb->getMotionState()->setWorldTransform(trans);
+		rb->setLinearVelocity(linearVelocity);
+		rb->setAngularVelocity(angularVelocity);
+		rb->setInterpolationLinearVelocity(linearVelocity);
+		rb->setInterpolationAngularVelocity(angularVelocity);
+		rb->clearForces();
+
+		if (body->isInWorld())
+		{
+			if (body->isEnabled() != (state.enabled != 0))
+			{
+				body->enabled = state.enabled != 0;
+				setBodyEnabled(body, body->enabled);
+			}
+
+			if (body->isEnabled())
+				obj->forceActivationState(state.activationState);
+			else
+				body->savedActivationState = state.activationState;
+
+			dynamicsWorld->updateSingleAabb(obj);
+		}
+		else
+			body->enabled = state.enabled != 0;
+
+		if (!body->isTrigger())
+		{
+			body->updateTransform();
+			body->updateRenderTransform();
+		}
+	}
+
+	//pairs touching before the restore may not be any more, they're found again on the next step
+	contactList.clear();
+	triggerPairs.clear();
+	stepCount = snapshot.step;
+}
@@ -2,6 +2,7 @@
 #include "btBulletDynamicsCommon.h"
 
 #include "RigidBody.h"
+#include "PhysicsSnapshot.h"
 #include "../../Common/Vector3.h"
 #include "../../Common/Quaternion.h"
 #include "../../CSC8508/Engine/Transform.h"
@@ -14,6 +15,8 @@ namespace NCL
 {
 	namespace CSC8508
 	{
+		class GameWorld;
+
 		namespace physics
 		{
 			//converts a vector3 to a btVector
@@ -34,6 +37,46 @@ namespace NCL
 
 			typedef std::pair<const btCollisionObject*, const btCollisionObject*> collisionPair;
 
+			//a pair of touching objects remembered between steps. The handles are checked before any
+			//end or exit event so records for deleted objects never need to be searched for and removed
+			struct contactRecord
+			{
+				collisionPair objects;
+				GameObjectHandle handleA;
+				GameObjectHandle handleB;
+
+				bool operator==(const contactRecord& other) const
+				{
+					return objects == other.objects && handleA == other.handleA && handleB == other.handleB;
+				}
+
+				bool operator<(const contactRecord& other) const
+				{
+					if (objects != other.objects)
+						return objects < other.objects;
+					if (handleA != other.handleA)
+						return handleA < other.handleA;
+					return handleB < other.handleB;
+				}
+			};
+
+			//a single ray for batched queries
+			struct RayQuery
+			{
+				NCL::Maths::Vector3 from;
+				NCL::Maths::Vector3 to;
+			};
+
+			//result of a batched ray, object is nullptr if nothing was hit
+			struct RayHit
+			{
+				GameObject* object = nullptr;
+				GameObjectHandle handle;
+				NCL::Maths::Vector3 point;
+				NCL::Maths::Vector3 normal;
+				float fraction = 1.0f;
+			};
+
 			class RigidBody;
 
 			class BulletWorld
@@ -43,33 +86,81 @@ namespace NCL
 				~BulletWorld();
 
 				void setGravity(NCL::Maths::Vector3 force);
+				//the world whose handle table is used to check objects are still alive
+				void setGameWorld(GameWorld* world) { gameWorld = world; }
+				void setFixedTimeStep(float step) { fixedTimeStep = step; }
+				float getFixedTimeStep() const { return fixedTimeStep; }
 				GameObject* rayIntersect(	NCL::Maths::Vector3 from, NCL::Maths::Vector3 to,
 									/*OUT*/ NCL::Maths::Vector3 pointHit);
+				void rayIntersectBatch(const std::vector<RayQuery>& rays, /*OUT*/ std::vector<RayHit>& hits, int workerCount = 1);
+
+				//queued rays are all cast together at the end of the next Update, the returned ticket
+				//reads the result back until the following Update
+				int queueRay(NCL::Maths::Vector3 from, NCL::Maths::Vector3 to);
+				RayHit getQueuedRayHit(int ticket) const;
 
 				void addRigidBody(RigidBody* body);
 				void addpointconstraint(RigidBody* bodyA, NCL::Maths::Vector3 point);
 				void addhingeconstraint(RigidBody* doorbody, NCL::Maths::Vector3 point, NCL::Maths::Vector3 axisA);
 				
 				void removeRigidBody(RigidBody* body);
+				void unregisterBody(RigidBody* body);
+				void setBodyEnabled(RigidBody* body, bool enabled);
 
 				void Update(float dt);
 				void checkCollisions();
+				void checkTriggers();
 				void clear();
 
+				int getBodyCount() const { return (int)rigidList.size(); }
+				int getTriggerCount() const { return (int)triggerList.size(); }
+				unsigned int getStepCount() const { return stepCount; }
+
+				void captureSnapshot(/*OUT*/ PhysicsSnapshot& snapshot) const;
+				void restoreSnapshot(const PhysicsSnapshot& snapshot);
+
 			private:
 				static void tickCallBack(btDynamicsWorld* world, btScalar timeStep);
+				static void nearCallBack(btBroadphasePair& collisionPair, btCollisionDispatcher& dispatcher, const btDispatcherInfo& dispatchInfo);
 				void updateObjects(float dt);
 
+				GameObject* resolve(GameObjectHandle handle) const;
+				contactRecord makeRecord(const btCollisionObject* obA, const btCollisionObject* obB) const;
+
+				void createDynamicsWorld();
+				void destroyDynamicsWorld();
+				void castRayRange(const std::vector<RayQuery>& rays, std::vector<RayHit>& hits, int start, int end) const;
+
 				btDefaultCollisionConfiguration* collisionConfiguration;
 				btCollisionDispatcher* dispatcher;
-				btBroadphaseInterface* overlappingPairCache;
+				btDbvtBroadphase* overlappingPairCache;
+				btGhostPairCallback* ghostPairCallback;
 				btSequentialImpulseConstraintSolver* solver;
 			
 				btDiscreteDynamicsWorld* dynamicsWorld;
 
+				btVector3 gravity;
+				GameWorld* gameWorld = nullptr;
+
+				//physics runs at a fixed rate, render transforms are interpolated between steps
+				float fixedTimeStep = 1.0f / 60.0f;
+				static const int MAX_SUB_STEPS = 10;
+
+				unsigned int stepCount = 0;
+
+				//every body created in this world indexed by its body id, null once deleted
+				std::vector<RigidBody*> bodyTable;
+				//each body stores its slot in this list so it can be swap removed
 				std::vector<RigidBody*> rigidList;
-				std::vector<collisionPair> contactList;
+				std::vector<RigidBody*> triggerList;
+				std::vector<contactRecord> contactList;
+				//trigger/object pairs overlapping as of the last step, kept sorted
+				std::vector<contactRecord> triggerPairs;
+				std::vector<contactRecord> currentTriggerPairs;
 				std::vector<btTypedConstraint*> constraintList;
+
+				std::vector<RayQuery> queuedRays;
+				std::vector<RayHit> queuedRayHits;
 			};
 		}
 	}
@@ -0,0 +1,60 @@
+#include "PhysicsSnapshot.h"
+
+#include <cstring>
+
+using namespace NCL;
+using namespace CSC8508;
+using namespace physics;
+
+namespace
+{
+	const unsigned int SNAPSHOT_MAGIC = 0x504E5350; //"PSNP"
+	const unsigned int SNAPSHOT_VERSION = 1;
+
+	struct SnapshotHeader
+	{
+		unsigned int magic;
+		unsigned int version;
+		unsigned int step;
+		unsigned int bodyCount;
+	};
+}
+
+//writes a header followed by the body records as they are in memory
+void PhysicsSnapshot::serialize(std::vector<char>& out) const
+{
+	SnapshotHeader header;
+	header.magic = SNAPSHOT_MAGIC;
+	header.version = SNAPSHOT_VERSION;
+	header.step = step;
+	header.bodyCount = (unsigned int)bodies.size();
+
+	size_t bodyBytes = bodies.size() * sizeof(BodySnapshot);
+	out.resize(sizeof(SnapshotHeader) + bodyBytes);
+	memcpy(out.data(), &header, sizeof(SnapshotHeader));
+	if (bodyBytes > 0)
+		memcpy(out.data() + sizeof(SnapshotHeader), bodies.data(), bodyBytes);
+}
+
+//returns false and leaves the snapshot untouched if the data isn't a snapshot of this version
+bool PhysicsSnapshot::deserialize(const char* data, size_t size)
+{
+	if (size < sizeof(SnapshotHeader))
+		return false;
+
+	SnapshotHeader header;
+	memcpy(&header, data, sizeof(SnapshotHeader));
+
+	if (header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION)
+		return false;
+
+	size_t bodyBytes = header.bodyCount * sizeof(BodySnapshot);
+	if (size < sizeof(SnapshotHeader) + bodyBytes)
+		return false;
+
+	step = header.step;
+	bodies.resize(header.bodyCount);
+	if (bodyBytes > 0)
+		memcpy(bodies.data(), data + sizeof(SnapshotHeader), bodyBytes);
+	return true;
+}
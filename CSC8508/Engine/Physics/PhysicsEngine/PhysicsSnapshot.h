@@ -0,0 +1,47 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+
+namespace NCL
+{
+	namespace CSC8508
+	{
+		namespace physics
+		{
+			//state of a single body, plain data so a whole snapshot can be copied as bytes
+			struct BodySnapshot
+			{
+				int bodyID;
+				float position[3];
+				float orientation[4];
+				float linearVelocity[3];
+				float angularVelocity[3];
+				int activationState;
+				int inWorld;
+				int enabled;
+			};
+
+			//compact copy of every rigid body's state in a BulletWorld. Captured and restored by the world,
+			//used to reset a level in place and as a base state for rollback
+			class PhysicsSnapshot
+			{
+			public:
+				void clear() { bodies.clear(); step = 0; }
+				bool isEmpty() const { return bodies.empty(); }
+
+				//number of fixed steps the world had taken when captured
+				unsigned int getStep() const { return step; }
+				const std::vector<BodySnapshot>& getBodies() const { return bodies; }
+
+				void serialize(std::vector<char>& out) const;
+				bool deserialize(const char* data, size_t size);
+
+			private:
+				friend class BulletWorld;
+
+				unsigned int step = 0;
+				std::vector<BodySnapshot> bodies;
+			};
+		}
+	}
+}
@@ -14,56 +14,115 @@ using namespace physics;
 RigidBody::RigidBody(Transform* parentTransform)
 {
 	body = nullptr;
+	ghost = nullptr;
 	colShape = nullptr;
+	sharedShape = nullptr;
 	worldRef = nullptr;
 	transform = parentTransform;
 }
 
 RigidBody::~RigidBody()
 {
-	if (worldRef)
-		worldRef->removeRigidBody(this);
+	if (worldRef && bodyID != -1)
+		worldRef->unregisterBody(this);
 
 	if (body)
 	{
-		delete body->getMotionState();
-		delete body;
+		ArenaDelete(body->getMotionState());
+		ArenaDelete(body);
 	}
 
-	if (colShape)
-		delete colShape;
+	if (ghost)
+		ArenaDelete(ghost);
+
+	releaseShape();
 }
 
+void RigidBody::releaseShape()
+{
+	if (sharedShape)
+	{
+		if (--sharedShape->users == 0)
+		{
+			ArenaDelete(sharedShape->shape);
+			delete sharedShape;
+		}
+	}
+	else if (colShape)
+		ArenaDelete(colShape);
+
+	colShape = nullptr;
+	sharedShape = nullptr;
+}
+
+//toggles the body in place. Bodies detached by a world clear are added back on activation
 void RigidBody::setActive(bool val)
 {
-	val ? worldRef->addRigidBody(this) : worldRef->removeRigidBody(this);
+	if (!body || !worldRef)
+		return;
+
+	if (!isInWorld())
+	{
+		if (val)
+			worldRef->addRigidBody(this);
+		enabled = val;
+		return;
+	}
+
+	if (enabled == val)
+		return;
+
+	enabled = val;
+	worldRef->setBodyEnabled(this, val);
+}
+
+//called by the world when it is destroyed or cleared, the bullet body outlives the world
+void RigidBody::detachFromWorld()
+{
+	worldIndex = -1;
+	bodyID = -1;
+	enabled = true;
+
+	if (body)
+	{
+		returnCollisionObject()->setWorldArrayIndex(-1);
+		returnCollisionObject()->forceActivationState(isKinemtic || followingParent ? DISABLE_DEACTIVATION : ACTIVE_TAG);
+	}
 }
 
 // collisoin shapes based on several primitives. Must be called before creating a body
 
 void RigidBody::addBoxShape(NCL::Maths::Vector3 halfExtents)
 {
-	colShape = new btBoxShape(btVector3(halfExtents.x, halfExtents.y, halfExtents.z));
+	colShape = ArenaNew<btBoxShape>(btVector3(halfExtents.x, halfExtents.y, halfExtents.z));
 }
 
 void RigidBody::addSphereShape(float radius)
 {
-	colShape = new btSphereShape(radius);
+	colShape = ArenaNew<btSphereShape>(radius);
 }
 
 void RigidBody::addCapsuleShape(float radius, float height)
 {
-	colShape = new btCapsuleShape(radius, height);
+	colShape = ArenaNew<btCapsuleShape>(radius, height);
 }
 
 void RigidBody::addCylinderShape(NCL::Maths::Vector3 halfExtents)
 {
-	colShape = new btCylinderShape(btVector3(halfExtents.x, halfExtents.y, halfExtents.z));
+	colShape = ArenaNew<btCylinderShape>(btVector3(halfExtents.x, halfExtents.y, halfExtents.z));
 }
 
 void RigidBody::addConeShape(float radius, float height)
 {
-	colShape = new btConeShape(radius, height);
+	colShape = ArenaNew<btConeShape>(radius, height);
+}
+
+void RigidBody::setShape(SharedShape* shape)
+{
+	releaseShape();
+	sharedShape = shape;
+	colShape = shape->shape;
+	++shape->users;
 }
 
 
@@ -128,14 +187,13 @@ void RigidBody::addTorqueImpulse(NCL::Maths::Vector3 torque)
 	}
 }
 
+//copies the simulation transform from the last fixed step into the game transform.
+//Bodies of child objects are moved by their parent instead
 void RigidBody::updateTransform()
 {
-	if (body)
+	if (body && !transform->GetParent())
 	{
-		btMotionState* shapeMotionTransform;
-		shapeMotionTransform = body->getMotionState();
-		btTransform worldTransform;
-		shapeMotionTransform->getWorldTransform(worldTransform);
+		const btTransform& worldTransform = body->getWorldTransform();
 
 		btVector3 pos = worldTransform.getOrigin();
 		btQuaternion rotation = worldTransform.getRotation();
@@ -147,13 +205,31 @@ void RigidBody::updateTransform()
 	}
 }
 
+//the motion state holds bullets interpolated transform, only used for rendering
+void RigidBody::updateRenderTransform()
+{
+	if (body && !transform->GetParent())
+	{
+		btMotionState* shapeMotionTransform;
+		shapeMotionTransform = body->getMotionState();
+		btTransform worldTransform;
+		shapeMotionTransform->getWorldTransform(worldTransform);
+
+		btVector3 pos = worldTransform.getOrigin();
+		btQuaternion rotation = worldTransform.getRotation();
+
+		transform->SetRenderPose(Vector3(pos.x(), pos.y(), pos.z()),
+			Quaternion(rotation.x(), rotation.y(), rotation.z(), rotation.w()));
+	}
+}
+
 void RigidBody::setTransform()
 {
 	if (body)
 	{
-		btQuaternion rotation = convertQuaternion(transform->GetOrientation());
+		btQuaternion rotation = convertQuaternion(transform->GetWorldOrientation());
 
-		NCL::Maths::Vector3 SetPosition = transform->GetPosition();
+		NCL::Maths::Vector3 SetPosition = transform->GetWorldPosition();
 		btVector3 position = convertVector3(SetPosition);
 		
 		btTransform newTransform;
@@ -161,6 +237,9 @@ void RigidBody::setTransform()
 		newTransform.setRotation(rotation);
 		body->setWorldTransform(newTransform);
 		body->getMotionState()->setWorldTransform(newTransform);
+
+		if (ghost)
+			ghost->setWorldTransform(newTransform);
 	}
 }
 
@@ -168,11 +247,14 @@ void RigidBody::setOrientation()
 {
 	if (body)
 	{
-		btQuaternion rotation = convertQuaternion(transform->GetOrientation());
+		btQuaternion rotation = convertQuaternion(transform->GetWorldOrientation());
 
 		btTransform trans = body->getWorldTransform();
 		trans.setRotation(rotation);
 		body->setWorldTransform(trans);
+
+		if (ghost)
+			ghost->setWorldTransform(trans);
 	}
 }
 
@@ -185,10 +267,10 @@ void RigidBody::createBody(	float mass,
 	{
 		worldRef = physicsWorld;
 
-		btQuaternion rotation = convertQuaternion(transform->GetOrientation());
-		btVector3 position = convertVector3(transform->GetPosition());
+		btQuaternion rotation = convertQuaternion(transform->GetWorldOrientation());
+		btVector3 position = convertVector3(transform->GetWorldPosition());
 
-		btDefaultMotionState* motionState = new btDefaultMotionState(btTransform(rotation, position));
+		btDefaultMotionState* motionState = ArenaNew<btDefaultMotionState>(btTransform(rotation, position));
 		btScalar bodyMass = mass;
 		btVector3 bodyInertia;
 		colShape->calculateLocalInertia(bodyMass, bodyInertia);
@@ -198,10 +280,13 @@ void RigidBody::createBody(	float mass,
 		bodyInfo.m_restitution = restitution;
 		bodyInfo.m_friction = friction;
 	
-		body = new btRigidBody(bodyInfo);
+		body = ArenaNew<btRigidBody>(bodyInfo);
 
 		body->setDamping(linearDamping, angularDamping);
 		worldRef->addRigidBody(this);
+
+		if (transform->GetParent())
+			setFollowParent(true);
 	}
 	
 }
@@ -210,6 +295,8 @@ void RigidBody::setUserPointer(void* object)
 {
 	if(body)
 		body->setUserPointer(object);
+	if (ghost)
+		ghost->setUserPointer(object);
 }
 
 void RigidBody::setDamping(float linear, float angular)
@@ -262,19 +349,25 @@ NCL::Maths::Vector3 RigidBody::getLinearVelocity()
 	return returnVector;
 }
 
+//turns the body into a trigger volume. A ghost object takes the body's place in the world so
+//overlaps are only tracked by the broadphase and never reach the narrowphase or the solver
 void RigidBody::makeTrigger()
 {
-	if (body)
-	{
-		body->setCollisionFlags(body->getCollisionFlags() | btCollisionObject::CF_NO_CONTACT_RESPONSE);
-		if (body->getMass() > 0)
-		{
-			btScalar bodyMass = 0;
-			btVector3 bodyInertia;
-			colShape->calculateLocalInertia(bodyMass, bodyInertia);
-			body->setMassProps(0,bodyInertia);
-		}
-	}
+	if (!body || ghost)
+		return;
+
+	bool wasInWorld = isInWorld();
+	if (wasInWorld)
+		worldRef->removeRigidBody(this);
+
+	ghost = ArenaNew<btGhostObject>();
+	ghost->setCollisionShape(colShape);
+	ghost->setWorldTransform(body->getWorldTransform());
+	ghost->setUserPointer(body->getUserPointer());
+	ghost->setCollisionFlags(ghost->getCollisionFlags() | btCollisionObject::CF_NO_CONTACT_RESPONSE);
+
+	if (wasInWorld)
+		worldRef->addRigidBody(this);
 }
 
 void RigidBody::makeKinematic()
@@ -291,6 +384,37 @@ void RigidBody::makeKinematic()
 
 }
 
+//kinematic bodies take their pose from the motion state each step, which setTransform keeps on the
+//parent. Bullet expects them to have no mass, so the mass is put back on detaching
+void RigidBody::setFollowParent(bool follow)
+{
+	if (!body || followingParent == follow)
+		return;
+
+	followingParent = follow;
+	if (isKinemtic)
+		return;
+
+	if (follow)
+	{
+		savedMass = body->getMass();
+		savedInertia = body->getLocalInertia();
+		body->setMassProps(0, btVector3(0, 0, 0));
+		body->setLinearVelocity(btVector3(0, 0, 0));
+		body->setAngularVelocity(btVector3(0, 0, 0));
+		body->setCollisionFlags(body->getCollisionFlags() | btCollisionObject::CF_KINEMATIC_OBJECT);
+		body->forceActivationState(DISABLE_DEACTIVATION);
+	}
+	else
+	{
+		body->setMassProps(savedMass, savedInertia);
+		body->setCollisionFlags(body->getCollisionFlags() & ~btCollisionObject::CF_KINEMATIC_OBJECT);
+		body->forceActivationState(ACTIVE_TAG);
+		body->activate(true);
+	}
+	body->updateInertiaTensor();
+}
+
 std::vector<std::string> RigidBody::debugInfo()
 {
 	vector<std::string> returnInfo;
@@ -1,9 +1,11 @@
 #pragma once
 #include "btBulletDynamicsCommon.h"
+#include "BulletCollision/CollisionDispatch/btGhostObject.h"
 
 #include "../../Common/Vector3.h"
 #include "../../Common/Quaternion.h"
 #include "../../CSC8508/Engine/Transform.h"
+#include "../../CSC8508/Engine/LevelArena.h"
 
 namespace NCL 
 {
@@ -12,8 +14,22 @@ namespace NCL
 		namespace physics
 		{
 			class BulletWorld;
-			class RigidBody
+
+			//a collision shape used by several bodies, deleted along with the last of them
+			struct SharedShape : public ArenaAllocated
+			{
+				//shape must come from ArenaNew
+				SharedShape(btCollisionShape* shape) : shape(shape), users(0) {}
+
+				btCollisionShape* shape;
+				int users;
+			};
+
+			//the body and everything bullet needs for it come from the level arena while a level loads
+			class RigidBody : public ArenaAllocated
 			{
+				friend class BulletWorld;
+
 			public:
 				RigidBody(Transform* parentTransform);
 				~RigidBody();
@@ -23,6 +39,8 @@ namespace NCL
 				void addCapsuleShape(float radius, float height);
 				void addCylinderShape(NCL::Maths::Vector3 halfExtents);
 				void addConeShape(float radius, float height);
+				//uses a shape built ahead of time, which can be given to any number of bodies
+				void setShape(SharedShape* shape);
 
 				void createBody(float mass,
 								float restitution,
@@ -31,15 +49,26 @@ namespace NCL
 				void setUserPointer(void* object);
 
 				void setActive(bool val);
+				bool isEnabled() const { return enabled; }
+				bool isInWorld() const { return worldIndex != -1; }
+				//stable id in the owning world, kept while the body is removed and re-added
+				int getBodyID() const { return bodyID; }
 
 				btRigidBody* returnBody() { return body; };
+				//the object actually in the world, the ghost for triggers and the body otherwise
+				btCollisionObject* returnCollisionObject() { return ghost ? (btCollisionObject*)ghost : (btCollisionObject*)body; }
+				bool isTrigger() const { return ghost != nullptr; }
 
 				void setTransform();
 				void setOrientation();
 				void updateTransform();
+				void updateRenderTransform();
 
 				void makeTrigger();
 				void makeKinematic();
+				//physics doesn't write back to child objects, so their bodies are carried along by the
+				//parent as kinematic bodies while attached and simulated again once detached
+				void setFollowParent(bool follow);
 				
 				void addForce(NCL::Maths::Vector3 force);
 				void addForceAtPos(NCL::Maths::Vector3 force, NCL::Maths::Vector3 pos);
@@ -65,10 +94,26 @@ namespace NCL
 				btScalar angularDamping = 0.7f;
 
 				bool isKinemtic = false;
+				bool followingParent = false;
+				bool enabled = true;
+
+				//slot in the owning world's body list, -1 when not in a world
+				int worldIndex = -1;
+				int bodyID = -1;
+				int savedFilterGroup = 0;
+				int savedFilterMask = 0;
+				int savedActivationState = ACTIVE_TAG;
+				btScalar savedMass = 0;
+				btVector3 savedInertia = btVector3(0, 0, 0);
+
+				void detachFromWorld();
+				void releaseShape();
 
 				Transform* transform;
 				btRigidBody* body;
+				btGhostObject* ghost;
 				btCollisionShape* colShape;
+				SharedShape* sharedShape;
 
 				BulletWorld* worldRef;
 
@@ -3,6 +3,7 @@
 #include "../../Common/Matrix3.h"
 
 #include "../Engine/Physics/PhysicsEngine/RigidBody.h"
+#include "LevelArena.h"
 
 using namespace NCL::Maths;
 
@@ -12,7 +13,7 @@ namespace NCL {
 	namespace CSC8508 {
 		class Transform;
 
-		class PhysicsObject	{
+		class PhysicsObject : public ArenaAllocated	{
 		public:
 			PhysicsObject(Transform* parentTransform, const CollisionVolume* parentVolume);
 			~PhysicsObject();
@@ -7,6 +7,7 @@
 #include "Constraint.h"
 
 #include "Debug.h"
+#include "Profiler.h"
 
 #include <functional>
 using namespace NCL;
@@ -86,8 +87,8 @@ void PhysicsSystem::Update(float dt) {
 
 	dTOffset += dt; //We accumulate time delta here - there might be remainders from previous frame!
 
-	GameTimer t;
-	t.GetTimeDeltaSeconds();
+	PROFILE_SCOPE("PhysicsSystem::Update");
+	uint64_t start = Profiler::Now();
 
 	//if (useBroadPhase) {
 	//	UpdateObjectAABBs();
@@ -120,8 +121,7 @@ void PhysicsSystem::Update(float dt) {
 
 	UpdateCollisionList(); //Remove any old collisions
 
-	t.Tick();
-	float updateTime = t.GetTimeDeltaSeconds();
+	float updateTime = (Profiler::Now() - start) / 1000000000.0f;
 
 	//Uh oh, physics is taking too long...
 	if (updateTime > realDT) {
@@ -0,0 +1,150 @@
+#include "Profiler.h"
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+
+using namespace NCL;
+using namespace CSC8508;
+
+std::atomic<bool> Profiler::enabled(true);
+std::mutex Profiler::bufferLock;
+std::vector<Profiler::ThreadBuffer*> Profiler::buffers;
+uint64_t Profiler::frameStart = 0;
+float Profiler::lastFrameMs = 0.0f;
+std::vector<Profiler::ZoneSummary> Profiler::lastFrameSummary;
+thread_local Profiler::ThreadBuffer* Profiler::threadBuffer = nullptr;
+
+namespace {
+	const std::chrono::steady_clock::time_point profilerEpoch = std::chrono::steady_clock::now();
+
+	void WriteEscaped(std::ostream& out, const char* text) {
+		for (const char* c = text; *c; ++c) {
+			if (*c == '"' || *c == '\\')
+				out << '\\';
+			out << *c;
+		}
+	}
+}
+
+uint64_t Profiler::Now() {
+	return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - profilerEpoch).count();
+}
+
+//buffers are made the first time a thread opens a zone and are never freed, the export may
+//still want them after the thread has gone
+Profiler::ThreadBuffer* Profiler::GetThreadBuffer() {
+	if (threadBuffer)
+		return threadBuffer;
+
+	ThreadBuffer* buffer = new ThreadBuffer();
+	buffer->ring.resize(RING_SIZE);
+	buffer->written = 0;
+	buffer->summarised = 0;
+	buffer->depth = 0;
+
+	buffer->jobThread = JobSystem::GetThreadIndex();
+	buffer->threadName = buffer->jobThread == 0 ? "Main" : "Worker " + std::to_string(buffer->jobThread);
+
+	{
+		std::lock_guard<std::mutex> guard(bufferLock);
+		buffer->thread = (unsigned int)buffers.size();
+		buffers.push_back(buffer);
+	}
+
+	threadBuffer = buffer;
+	return buffer;
+}
+
+void Profiler::EndFrame() {
+	uint64_t now = Now();
+	lastFrameMs = (now - frameStart) / 1000000.0f;
+	frameStart = now;
+
+	lastFrameSummary.clear();
+
+	std::lock_guard<std::mutex> guard(bufferLock);
+	for (auto buffer : buffers) {
+		uint64_t written = buffer->written.load(std::memory_order_acquire);
+		//anything older than a full ring has already been overwritten
+		uint64_t first = std::max(buffer->summarised, written > RING_SIZE ? written - RING_SIZE : 0);
+
+		for (uint64_t i = first; i < written; ++i) {
+			const ZoneRecord& record = buffer->ring[i % RING_SIZE];
+
+			auto summary = std::find_if(lastFrameSummary.begin(), lastFrameSummary.end(), [&](const ZoneSummary& s) {
+				return s.thread == buffer->jobThread && s.depth == record.depth && s.name == record.name;
+			});
+
+			if (summary == lastFrameSummary.end()) {
+				ZoneSummary s;
+				s.name = record.name;
+				s.thread = buffer->jobThread;
+				s.depth = record.depth;
+				s.calls = 0;
+				s.totalMs = 0.0f;
+				s.firstStart = record.start;
+				lastFrameSummary.push_back(s);
+				summary = lastFrameSummary.end() - 1;
+			}
+
+			summary->calls++;
+			summary->totalMs += (record.end - record.start) / 1000000.0f;
+			summary->firstStart = std::min(summary->firstStart, record.start);
+		}
+		buffer->summarised = written;
+	}
+
+	//zones finish before their parents, sorting by start time puts parents back above their children
+	std::sort(lastFrameSummary.begin(), lastFrameSummary.end(), [](const ZoneSummary& a, const ZoneSummary& b) {
+		if (a.thread != b.thread)
+			return a.thread < b.thread;
+		if (a.firstStart != b.firstStart)
+			return a.firstStart < b.firstStart;
+		return a.depth < b.depth;
+	});
+}
+
+bool Profiler::WriteChromeTrace(const std::string& fileName) {
+	std::ofstream out(fileName);
+	if (!out) {
+		std::cout << "Profiler: couldn't open " << fileName << " for writing" << std::endl;
+		return false;
+	}
+
+	std::lock_guard<std::mutex> guard(bufferLock);
+
+	size_t zoneCount = 0;
+	bool first = true;
+	out << std::fixed << std::setprecision(3);
+	out << "{\"traceEvents\":[\n";
+
+	for (auto buffer : buffers) {
+		if (!first)
+			out << ",\n";
+		first = false;
+		out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->thread
+			<< ",\"args\":{\"name\":\"" << buffer->threadName << "\"}}";
+
+		uint64_t written = buffer->written.load(std::memory_order_acquire);
+		uint64_t oldest = written > RING_SIZE ? written - RING_SIZE : 0;
+
+		//trace timestamps are in microseconds
+		for (uint64_t i = oldest; i < written; ++i) {
+			const ZoneRecord& record = buffer->ring[i % RING_SIZE];
+			out << ",\n{\"name\":\"";
+			WriteEscaped(out, record.name);
+			out << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->thread
+				<< ",\"ts\":" << record.start / 1000.0
+				<< ",\"dur\":" << (record.end - record.start) / 1000.0 << "}";
+			zoneCount++;
+		}
+	}
+
+	out << "\n]}\n";
+	std::cout << "Profiler: wrote " << zoneCount << " zones to " << fileName << std::endl;
+	return true;
+}
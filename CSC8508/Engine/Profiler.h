@@ -0,0 +1,126 @@
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+//PROFILE_SCOPE times the rest of the enclosing block. Names are stored as pointers, so they have to
+//outlive the profiler - string literals or strings owned by something that is never freed.
+//Defining NCL_DISABLE_PROFILER compiles every zone out
+#ifndef NCL_DISABLE_PROFILER
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) NCL::CSC8508::ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+#else
+#define PROFILE_SCOPE(name)
+#define PROFILE_FUNCTION()
+#endif
+
+namespace NCL {
+	namespace CSC8508 {
+
+		//hierarchical CPU profiler. Each thread writes finished zones into its own ring buffer, so
+		//recording never takes a lock and the buffers always hold the most recent zones, ready to be
+		//exported as a Chrome trace (chrome://tracing or ui.perfetto.dev)
+		class Profiler {
+		public:
+			struct ZoneRecord {
+				const char*		name;
+				uint64_t		start;
+				uint64_t		end;
+				int				depth;
+			};
+
+			//one line of the per frame summary, zones with the same name at the same depth are merged
+			struct ZoneSummary {
+				const char*		name;
+				//job system thread index, 0 is the main thread
+				unsigned int	thread;
+				int				depth;
+				int				calls;
+				float			totalMs;
+				uint64_t		firstStart;
+			};
+
+			//nanoseconds since the profiler started
+			static uint64_t Now();
+
+			static void SetEnabled(bool on) { enabled = on; }
+			static bool IsEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+			//call once a frame, after everything that frame has finished, to build the summary
+			static void EndFrame();
+			static const std::vector<ZoneSummary>& GetLastFrameSummary() { return lastFrameSummary; }
+			static float GetLastFrameTime() { return lastFrameMs; }
+
+			//writes everything still in the ring buffers, false if the file couldn't be opened
+			static bool WriteChromeTrace(const std::string& fileName);
+
+		private:
+			friend class ProfileZone;
+
+			static const unsigned int RING_SIZE = 1 << 15;
+
+			struct ThreadBuffer {
+				std::vector<ZoneRecord> ring;
+				std::atomic<uint64_t> written;
+				uint64_t summarised;
+				int depth;
+				unsigned int thread;
+				unsigned int jobThread;
+				std::string threadName;
+			};
+
+			static ThreadBuffer* GetThreadBuffer();
+
+			static std::atomic<bool> enabled;
+			static std::mutex bufferLock;
+			static std::vector<ThreadBuffer*> buffers;
+			static thread_local ThreadBuffer* threadBuffer;
+
+			static uint64_t frameStart;
+			static float lastFrameMs;
+			static std::vector<ZoneSummary> lastFrameSummary;
+		};
+
+		class ProfileZone {
+		public:
+			ProfileZone(const char* name) {
+				if (!Profiler::IsEnabled()) {
+					buffer = nullptr;
+					return;
+				}
+				buffer = Profiler::GetThreadBuffer();
+				this->name = name;
+				depth = buffer->depth++;
+				start = Profiler::Now();
+			}
+
+			~ProfileZone() {
+				if (!buffer)
+					return;
+
+				uint64_t index = buffer->written.load(std::memory_order_relaxed);
+				Profiler::ZoneRecord& record = buffer->ring[index % Profiler::RING_SIZE];
+				record.name = name;
+				record.start = start;
+				record.end = Profiler::Now();
+				record.depth = depth;
+
+				buffer->depth--;
+				buffer->written.store(index + 1, std::memory_order_release);
+			}
+
+			ProfileZone(const ProfileZone&) = delete;
+			ProfileZone& operator=(const ProfileZone&) = delete;
+
+		private:
+			Profiler::ThreadBuffer* buffer;
+			const char* name;
+			uint64_t start;
+			int depth;
+		};
+	}
+}
@@ -1,4 +1,5 @@
 #include "RenderObject.h"
+#include "GameObject.h"
 #include "../../Common/MeshGeometry.h"
 #include "../../Common/MeshMaterial.h"
 #include "../../Common/MeshAnimation.h"
@@ -27,6 +28,10 @@ void RenderObject::SetAnimation(MeshAnimation* anim) {
 		animRelativeJoints = anim->GenerateRelativeJoints(mesh->GetInverseBindPose());
 		frameTime = 1.0f / animation->GetFrameRate();
 	}
+
+	//objects only get their animation updated while they have one
+	if (transform && transform->GetGameObject())
+		transform->GetGameObject()->RefreshActiveLists();
 }
 
 void RenderObject::Update(float dt) {
@@ -3,6 +3,7 @@
 #include "../../Common/TextureBase.h"
 #include "../../Common/ShaderBase.h"
 #include "../../Common/Vector4.h"
+#include "LevelArena.h"
 #include <vector>
 
 namespace NCL {
@@ -16,7 +17,7 @@ namespace NCL {
 		class Transform;
 		using namespace Maths;
 
-		class RenderObject
+		class RenderObject : public ArenaAllocated
 		{
 		public:
 			RenderObject(Transform* parentTransform, MeshGeometry* mesh, MeshMaterial* mat, TextureBase* tex, MeshAnimation* anim, ShaderBase* shader);
@@ -0,0 +1,37 @@
+#include "Tags.h"
+
+#include <iostream>
+
+using namespace NCL::CSC8508;
+
+std::unordered_map<std::string, TagID> Tags::ids;
+std::vector<std::string> Tags::names;
+std::mutex Tags::lock;
+
+TagID Tags::Intern(const std::string& name) {
+	std::lock_guard<std::mutex> guard(lock);
+	auto found = ids.find(name);
+	if (found != ids.end())
+		return found->second;
+
+	//names come from level files, so running out isn't a programming error
+	if (names.size() >= MAX_TAGS) {
+		std::cout << "Tags: no room for tag " << name << ", " << MAX_TAGS << " tags are already in use" << std::endl;
+		return INVALID_TAG;
+	}
+
+	//reserved up front so GetName's references stay valid as names are added
+	if (names.empty())
+		names.reserve(MAX_TAGS);
+
+	TagID id = (TagID)names.size();
+	ids[name] = id;
+	names.push_back(name);
+	return id;
+}
+
+TagID Tags::Find(const std::string& name) {
+	std::lock_guard<std::mutex> guard(lock);
+	auto found = ids.find(name);
+	return found != ids.end() ? found->second : INVALID_TAG;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+
+namespace NCL {
+	namespace CSC8508 {
+
+		typedef unsigned int TagID;
+		const unsigned int MAX_TAGS = 64;
+		const TagID INVALID_TAG = MAX_TAGS;
+
+		//tag names are interned once, usually at load time, objects and the world only deal in ids.
+		//Interning and lookups are locked, so level loading jobs and parallel updates can use them
+		class Tags {
+		public:
+			//returns the id for the name, giving it a new one if it hasn't been seen before.
+			//INVALID_TAG once MAX_TAGS names are in use
+			static TagID Intern(const std::string& name);
+			//returns INVALID_TAG if no object has ever been given the name
+			static TagID Find(const std::string& name);
+			static const std::string& GetName(TagID id) { return names[id]; }
+			static unsigned int Count() { return (unsigned int)names.size(); }
+
+		private:
+			static std::unordered_map<std::string, TagID> ids;
+			static std::vector<std::string> names;
+			static std::mutex lock;
+		};
+	}
+}
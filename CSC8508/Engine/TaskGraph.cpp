@@ -0,0 +1,143 @@
+#include "TaskGraph.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <exception>
+
+using namespace NCL;
+using namespace CSC8508;
+
+namespace {
+	float MillisecondsBetween(std::chrono::high_resolution_clock::time_point from, std::chrono::high_resolution_clock::time_point to) {
+		return std::chrono::duration<float, std::milli>(to - from).count();
+	}
+}
+
+TaskID TaskGraph::AddTask(const std::string& name, const std::function<void()>& func, bool mainThreadOnly) {
+	Task task;
+	task.name = name;
+	task.func = func;
+	task.mainThreadOnly = mainThreadOnly;
+	tasks.push_back(task);
+	return (TaskID)tasks.size() - 1;
+}
+
+void TaskGraph::AddDependency(TaskID task, TaskID dependency) {
+	if (task < 0 || task >= (TaskID)tasks.size() || dependency < 0 || dependency >= (TaskID)tasks.size())
+		throw std::exception("TaskGraph::AddDependency: unknown task id");
+
+	//tasks can only depend on tasks added before them, which rules out cycles
+	if (dependency >= task)
+		throw std::exception("TaskGraph::AddDependency: a task can only depend on an earlier task");
+
+	tasks[task].dependencies.push_back(dependency);
+	tasks[dependency].dependents.push_back(task);
+}
+
+void TaskGraph::Run() {
+	int count = (int)tasks.size();
+	if (count == 0)
+		return;
+
+	runStart = std::chrono::high_resolution_clock::now();
+
+	timings.resize(count);
+	remaining.reset(new std::atomic<int>[count]);
+	for (int i = 0; i < count; ++i) {
+		remaining[i] = (int)tasks[i].dependencies.size();
+		timings[i] = TaskTiming();
+		timings[i].name = tasks[i].name;
+	}
+	finished = 0;
+
+	for (int i = 0; i < count; ++i) {
+		if (tasks[i].dependencies.empty())
+			Schedule(i);
+	}
+
+	//the calling thread runs main thread tasks as they become ready and helps with jobs otherwise
+	while (finished.load() < count) {
+		TaskID next = -1;
+		{
+			std::lock_guard<std::mutex> guard(mainQueueLock);
+			if (!mainQueue.empty()) {
+				next = mainQueue.front();
+				mainQueue.pop_front();
+			}
+		}
+
+		if (next != -1)
+			Execute(next);
+		else if (!JobSystem::TryRunJob())
+			std::this_thread::yield();
+	}
+
+	frameTime = MillisecondsBetween(runStart, std::chrono::high_resolution_clock::now());
+	MarkCriticalPath();
+}
+
+void TaskGraph::Schedule(TaskID id) {
+	if (tasks[id].mainThreadOnly) {
+		std::lock_guard<std::mutex> guard(mainQueueLock);
+		mainQueue.push_back(id);
+	}
+	else
+		JobSystem::Run([this, id]() { Execute(id); });
+}
+
+void TaskGraph::Execute(TaskID id) {
+	TaskTiming& timing = timings[id];
+	timing.thread = JobSystem::GetThreadIndex();
+	timing.start = MillisecondsBetween(runStart, std::chrono::high_resolution_clock::now());
+
+	{
+		//task names live as long as the graph does
+		PROFILE_SCOPE(tasks[id].name.c_str());
+		tasks[id].func();
+	}
+
+	timing.end = MillisecondsBetween(runStart, std::chrono::high_resolution_clock::now());
+
+	for (TaskID dependent : tasks[id].dependents) {
+		if (--remaining[dependent] == 0)
+			Schedule(dependent);
+	}
+	finished++;
+}
+
+//walks back from the last task to finish, always through the dependency that finished last,
+//which is the chain of tasks that decided how long the frame took
+void TaskGraph::MarkCriticalPath() {
+	TaskID current = 0;
+	for (TaskID i = 1; i < (TaskID)timings.size(); ++i) {
+		if (timings[i].end > timings[current].end)
+			current = i;
+	}
+
+	while (current != -1) {
+		timings[current].critical = true;
+
+		TaskID latest = -1;
+		for (TaskID dependency : tasks[current].dependencies) {
+			if (latest == -1 || timings[dependency].end > timings[latest].end)
+				latest = dependency;
+		}
+		current = latest;
+	}
+}
+
+void TaskGraph::PrintLastTimings() const {
+	std::cout << "Frame task graph: " << std::fixed << std::setprecision(3) << frameTime << "ms\n";
+	for (auto const& i : timings) {
+		std::cout << (i.critical ? " * " : "   ") << std::left << std::setw(16) << i.name << std::right
+			<< " start " << std::setw(8) << i.start
+			<< " end " << std::setw(8) << i.end
+			<< " took " << std::setw(8) << (i.end - i.start)
+			<< " thread " << i.thread << "\n";
+	}
+	std::cout << " * critical path" << std::endl;
+	std::cout.unsetf(std::ios::floatfield);
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+namespace NCL {
+	namespace CSC8508 {
+
+		typedef int TaskID;
+
+		//a fixed set of tasks with declared dependencies, built once and run every frame.
+		//A task starts as soon as everything it depends on has finished, tasks that don't depend on
+		//each other run at the same time on the job system. Main thread tasks (anything touching
+		//the GL context or the window) are only ever run by the thread that called Run
+		class TaskGraph {
+		public:
+			struct TaskTiming {
+				std::string name;
+				//milliseconds since the start of Run
+				float start = 0.0f;
+				float end = 0.0f;
+				unsigned int thread = 0;
+				bool critical = false;
+			};
+
+			TaskID AddTask(const std::string& name, const std::function<void()>& func, bool mainThreadOnly = false);
+			//task won't start until dependency has finished
+			void AddDependency(TaskID task, TaskID dependency);
+
+			//runs every task once, returns when they have all finished
+			void Run();
+
+			//timings from the last Run, in the order the tasks were added
+			const std::vector<TaskTiming>& GetLastTimings() const { return timings; }
+			float GetLastFrameTime() const { return frameTime; }
+			void PrintLastTimings() const;
+
+		protected:
+			struct Task {
+				std::string name;
+				std::function<void()> func;
+				bool mainThreadOnly = false;
+				std::vector<TaskID> dependents;
+				std::vector<TaskID> dependencies;
+			};
+
+			void Schedule(TaskID id);
+			void Execute(TaskID id);
+			void MarkCriticalPath();
+
+			std::vector<Task> tasks;
+			std::vector<TaskTiming> timings;
+			float frameTime = 0.0f;
+
+			//per run state
+			std::chrono::high_resolution_clock::time_point runStart;
+			std::unique_ptr<std::atomic<int>[]> remaining;
+			std::atomic<int> finished{ 0 };
+			std::mutex mainQueueLock;
+			std::deque<TaskID> mainQueue;
+		};
+	}
+}
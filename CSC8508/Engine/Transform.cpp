@@ -2,53 +2,268 @@
 #include "Debug.h"
 #include "GameObject.h"
 #include "PhysicsObject.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "AllocationTracker.h"
 
 #include <iomanip>
 #include <sstream>
+#include <iostream>
+#include <algorithm>
 
 using namespace NCL::CSC8508;
 
+std::vector<Transform*> Transform::dirtyTransforms;
+std::vector<Transform*> Transform::flushingTransforms;
+std::vector<Transform*> Transform::flushLevel;
+std::vector<Transform*> Transform::flushNextLevel;
+std::mutex Transform::dirtyLock;
+
+namespace {
+	//rebuilding a matrix is a few multiplies, smaller batches aren't worth a job
+	const int MIN_TRANSFORMS_PER_JOB = 256;
+}
+
 Transform::Transform(GameObject* object)
 {
 	this->gameObject = object;
 	scale	= Vector3(1, 1, 1);
+	parent = nullptr;
+	matrixDirty = false;
+	renderMatrixDirty = false;
+	dirtyIndex = -1;
 }
 
 Transform::~Transform()
 {
+	//children stay where they are in the world
+	std::vector<Transform*> orphans = children;
+	for (auto child : orphans)
+		child->SetParent(nullptr);
+
+	if (parent) {
+		auto& siblings = parent->children;
+		siblings.erase(std::find(siblings.begin(), siblings.end(), this));
+	}
 
+	if (dirtyIndex != -1) {
+		std::lock_guard<std::mutex> guard(dirtyLock);
+		dirtyTransforms[dirtyIndex] = nullptr;
+	}
 }
 
 void Transform::UpdateMatrix() {
+	RebuildMatrix();
+	RebuildRenderMatrix();
+}
+
+void Transform::RebuildMatrix() const {
 	matrix =
 		Matrix4::Translation(position) *
 		Matrix4(orientation) *
 		Matrix4::Scale(scale);
+	matrixDirty = false;
+}
+
+void Transform::RebuildRenderMatrix() const {
+	renderMatrix =
+		Matrix4::Translation(renderPosition) *
+		Matrix4(renderOrientation) *
+		Matrix4::Scale(scale);
+	renderMatrixDirty = false;
+}
+
+//parents are always rebuilt before their children so their world matrices are already up to date
+void Transform::RebuildWorldMatrices() {
+	if (parent) {
+		worldMatrix = parent->worldMatrix * GetLocalMatrix();
+		renderWorldMatrix = parent->renderWorldMatrix * GetLocalRenderMatrix();
+	}
+	else {
+		worldMatrix = GetLocalMatrix();
+		renderWorldMatrix = GetLocalRenderMatrix();
+	}
+}
+
+bool Transform::InChangedSubtree() const {
+	for (const Transform* t = this; t; t = t->parent) {
+		if (t->dirtyIndex != -1)
+			return true;
+	}
+	return false;
 }
 
-Transform& Transform::SetPosition(const Vector3& worldPos, bool updatePhysics) {
-	position = worldPos;
+//the cached world matrix is only written by the flush, until then it's worked out from the parents
+Matrix4 Transform::GetMatrix() const {
+	if (!InChangedSubtree())
+		return worldMatrix;
+	return parent ? parent->GetMatrix() * GetLocalMatrix() : GetLocalMatrix();
+}
+
+Matrix4 Transform::GetRenderMatrix() const {
+	if (!InChangedSubtree())
+		return renderWorldMatrix;
+	return parent ? parent->GetRenderMatrix() * GetLocalRenderMatrix() : GetLocalRenderMatrix();
+}
+
+Vector3 Transform::GetWorldPosition() const {
+	return parent ? parent->GetMatrix() * position : position;
+}
+
+Quaternion Transform::GetWorldOrientation() const {
+	return parent ? parent->GetWorldOrientation() * orientation : orientation;
+}
+
+Vector3 Transform::GetWorldRenderPosition() const {
+	return parent ? parent->GetRenderMatrix() * renderPosition : renderPosition;
+}
+
+Quaternion Transform::GetWorldRenderOrientation() const {
+	return parent ? parent->GetWorldRenderOrientation() * renderOrientation : renderOrientation;
+}
+
+void Transform::SetParent(Transform* newParent) {
+	if (newParent == parent)
+		return;
+
+	for (Transform* t = newParent; t; t = t->parent) {
+		if (t == this) {
+			std::cout << "Transform::SetParent: can't parent an object to one of its own children\n";
+			return;
+		}
+	}
+
+	Vector3 worldPos = GetWorldPosition();
+	Quaternion worldOr = GetWorldOrientation();
+
+	if (parent) {
+		auto& siblings = parent->children;
+		siblings.erase(std::find(siblings.begin(), siblings.end(), this));
+	}
+
+	parent = newParent;
+
+	if (parent) {
+		parent->children.push_back(this);
+		worldPos = parent->GetMatrix().Inverse() * worldPos;
+		worldOr = parent->GetWorldOrientation().Conjugate() * worldOr;
+	}
+
+	//goes through the setters so the render pose snaps and the body follows
+	SetPosition(worldPos);
+	SetOrientation(worldOr);
+
+	if (gameObject->GetPhysicsObject())
+		gameObject->GetPhysicsObject()->body->setFollowParent(parent != nullptr);
+}
+
+//queued the first time it changes, further changes before the flush are free
+void Transform::MarkDirty(bool simulation, bool render) {
+	matrixDirty |= simulation;
+	renderMatrixDirty |= render;
+
+	if (dirtyIndex == -1) {
+		std::lock_guard<std::mutex> guard(dirtyLock);
+		dirtyIndex = (int)dirtyTransforms.size();
+		dirtyTransforms.push_back(this);
+	}
+}
+
+void Transform::FlushDirtyTransforms() {
+	PROFILE_SCOPE("Transform::FlushDirtyTransforms");
+	ALLOC_SCOPE(AllocTag::Transforms);
+	//the lock isn't held while rebuilding, this thread may pick up other jobs while it waits
+	{
+		std::lock_guard<std::mutex> guard(dirtyLock);
+		flushingTransforms.swap(dirtyTransforms);
+
+		//only transforms with no changed parent start a subtree, the rest are reached from it
+		flushLevel.clear();
+		for (auto t : flushingTransforms) {
+			if (t && !(t->parent && t->parent->InChangedSubtree()))
+				flushLevel.push_back(t);
+		}
+	}
+
+	//each transform only touches itself so the queue can be split between threads
+	JobSystem::ParallelFor((int)flushingTransforms.size(), MIN_TRANSFORMS_PER_JOB, [](int begin, int end) {
+		for (int i = begin; i < end; ++i) {
+			Transform* t = flushingTransforms[i];
+			if (!t)
+				continue;
+
+			if (t->matrixDirty)
+				t->RebuildMatrix();
+			if (t->renderMatrixDirty)
+				t->RebuildRenderMatrix();
+		}
+	});
+
+	//world matrices go down the changed subtrees a level at a time. Everything in a level only
+	//reads from the level above, so each level can be split between threads
+	while (!flushLevel.empty()) {
+		JobSystem::ParallelFor((int)flushLevel.size(), MIN_TRANSFORMS_PER_JOB, [](int begin, int end) {
+			for (int i = begin; i < end; ++i)
+				flushLevel[i]->RebuildWorldMatrices();
+		});
+
+		flushNextLevel.clear();
+		for (auto t : flushLevel) {
+			flushNextLevel.insert(flushNextLevel.end(), t->children.begin(), t->children.end());
+
+			//bodies of child objects follow their parent, physics doesn't move them
+			if (t->parent && t->gameObject->GetPhysicsObject())
+				t->gameObject->GetPhysicsObject()->body->setTransform();
+		}
+		flushLevel.swap(flushNextLevel);
+	}
+
+	//the world matrices are only trusted once the whole subtree has been rebuilt
+	{
+		std::lock_guard<std::mutex> guard(dirtyLock);
+		for (auto t : flushingTransforms) {
+			if (t)
+				t->dirtyIndex = -1;
+		}
+		flushingTransforms.clear();
+	}
+}
+
+//Setting the simulation transform snaps the render pose too, physics will overwrite it
+//with the interpolated pose after its next update.
+Transform& Transform::SetPosition(const Vector3& localPos, bool updatePhysics) {
+	position = localPos;
+	renderPosition = localPos;
 
 	if (updatePhysics && gameObject->GetPhysicsObject())
 		gameObject->GetPhysicsObject()->body->setTransform();
 
-	UpdateMatrix();
+	MarkDirty(true, true);
 	return *this;
 }
 
-Transform& Transform::SetScale(const Vector3& worldScale) {
-	scale = worldScale;
-	UpdateMatrix();
+Transform& Transform::SetScale(const Vector3& localScale) {
+	scale = localScale;
+	MarkDirty(true, true);
 	return *this;
 }
 
-Transform& Transform::SetOrientation(const Quaternion& worldOrientation, bool updatePhysics) {
-	orientation = worldOrientation;
+Transform& Transform::SetOrientation(const Quaternion& localOrientation, bool updatePhysics) {
+	orientation = localOrientation;
+	renderOrientation = localOrientation;
 
 	if (updatePhysics && gameObject->GetPhysicsObject())
 		gameObject->GetPhysicsObject()->body->setOrientation();
 
-	UpdateMatrix();
+	MarkDirty(true, true);
+	return *this;
+}
+
+Transform& Transform::SetRenderPose(const Vector3& renderPos, const Quaternion& renderOr) {
+	renderPosition = renderPos;
+	renderOrientation = renderOr;
+
+	MarkDirty(false, true);
 	return *this;
 }
 
@@ -72,5 +287,10 @@ std::vector<std::string> Transform::GetDebugInfo() const {
 	info.push_back(stream.str());
 	stream.str("");
 
+	if (parent)
+		info.push_back("  Parent: " + parent->gameObject->GetName());
+	if (!children.empty())
+		info.push_back("  Children: " + std::to_string(children.size()));
+
 	return info;
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "../../Common/Quaternion.h"
 
 #include <vector>
+#include <mutex>
 
 using std::vector;
 
@@ -14,14 +15,25 @@ namespace NCL {
 	namespace CSC8508 {
 		class GameObject;
 
+		//matrices are rebuilt lazily. Setters only mark the transform dirty and queue it, the queue is
+		//flushed once a frame before rendering so the renderer only ever reads clean matrices.
+		//Position, orientation and scale are relative to the parent transform if there is one,
+		//GetMatrix and GetRenderMatrix give the world matrix.
+		//Only the queue is locked. A transform can be changed by one thread at a time and mustn't be
+		//read while another changes it, and nothing may change or read matrices during the flush.
+		//The frame graph runs the flush after every task that moves objects
 		class Transform
 		{
 		public:
 			Transform(GameObject* object);
 			~Transform();
 
-			Transform& SetPosition(const Vector3& worldPos, bool updatePhysics = true);
-			Transform& SetScale(const Vector3& worldScale);
+			//the dirty queue holds pointers, so transforms stay with their object
+			Transform(const Transform&) = delete;
+			Transform& operator=(const Transform&) = delete;
+
+			Transform& SetPosition(const Vector3& localPos, bool updatePhysics = true);
+			Transform& SetScale(const Vector3& localScale);
 			Transform& SetOrientation(const Quaternion& newOr, bool updatePhysics = true);
 
 			Vector3 GetPosition() const {
@@ -36,20 +48,89 @@ namespace NCL {
 				return orientation;
 			}
 
-			Matrix4 GetMatrix() const {
+			Vector3 GetWorldPosition() const;
+			Quaternion GetWorldOrientation() const;
+
+			Matrix4 GetLocalMatrix() const {
+				if (matrixDirty)
+					RebuildMatrix();
 				return matrix;
 			}
+			Matrix4 GetMatrix() const;
 			void UpdateMatrix();
 
+			//children keep their world pose when attached or detached, null detaches
+			void SetParent(Transform* newParent);
+			Transform* GetParent() const { return parent; }
+			const std::vector<Transform*>& GetChildren() const { return children; }
+			GameObject* GetGameObject() const { return gameObject; }
+
+			//Interpolated pose written by physics between fixed steps. Gameplay code should
+			//keep using the simulation transform above, rendering uses this one.
+			Transform& SetRenderPose(const Vector3& renderPos, const Quaternion& renderOr);
+
+			Vector3 GetRenderPosition() const {
+				return renderPosition;
+			}
+
+			Quaternion GetRenderOrientation() const {
+				return renderOrientation;
+			}
+
+			Vector3 GetWorldRenderPosition() const;
+			Quaternion GetWorldRenderOrientation() const;
+
+			Matrix4 GetLocalRenderMatrix() const {
+				if (renderMatrixDirty)
+					RebuildRenderMatrix();
+				return renderMatrix;
+			}
+			Matrix4 GetRenderMatrix() const;
+
+			bool IsDirty() const { return matrixDirty || renderMatrixDirty; }
+
+			//rebuilds the matrices of every transform changed since the last flush, then the world
+			//matrices of their subtrees one level at a time
+			static void FlushDirtyTransforms();
+			static size_t GetDirtyCount() { return dirtyTransforms.size(); }
+
 			std::vector<std::string> GetDebugInfo() const;
 
 		protected:
+			void MarkDirty(bool simulation, bool render);
+			void RebuildMatrix() const;
+			void RebuildRenderMatrix() const;
+			void RebuildWorldMatrices();
+			//true if this or a parent has changed since the last flush, so the cached world matrices are stale
+			bool InChangedSubtree() const;
+
 			GameObject* gameObject;
-			Matrix4		matrix;
+			mutable Matrix4	matrix;
 			Quaternion	orientation;
 			Vector3		position;
 
 			Vector3		scale;
+
+			mutable Matrix4	renderMatrix;
+			Quaternion	renderOrientation;
+			Vector3		renderPosition;
+
+			Transform*				parent;
+			std::vector<Transform*>	children;
+			//only written by the flush
+			Matrix4		worldMatrix;
+			Matrix4		renderWorldMatrix;
+
+			mutable bool matrixDirty;
+			mutable bool renderMatrixDirty;
+			//slot in the dirty queue, -1 if not queued
+			int			dirtyIndex;
+
+			static std::vector<Transform*> dirtyTransforms;
+			static std::vector<Transform*> flushingTransforms;
+			static std::vector<Transform*> flushLevel;
+			static std::vector<Transform*> flushNextLevel;
+			static std::mutex dirtyLock;
 		};
 	}
 }
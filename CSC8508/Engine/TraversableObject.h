@@ -9,7 +9,7 @@ namespace NCL {
 		public:
 			TraversableObject(std::string name = "", char type = '.') :GameObject(name) {
 				traversalType = type;
-				tags.insert("traversable");
+				AddTag("traversable");
 			}
 
 			char TraversalType() const { return traversalType; }
@@ -0,0 +1,42 @@
+#pragma once
+#include "GameObjectHandle.h"
+#include "Component.h"
+
+#include "../../Common/Vector3.h"
+#include "../../Common/Quaternion.h"
+
+#include <vector>
+
+namespace NCL {
+	namespace CSC8508 {
+
+		//state of a single object, its components' state is in the snapshot's buffer
+		struct ObjectSnapshot {
+			GameObjectHandle	handle;
+			Maths::Vector3		position;
+			Maths::Quaternion	orientation;
+			Maths::Vector3		scale;
+			bool				isActive;
+			unsigned int		firstComponent;
+			unsigned int		componentCount;
+		};
+
+		//copy of every non persistent object in a GameWorld. Captured and restored by the world, the
+		//objects themselves are kept so a level can be put back in place without loading it again
+		class WorldSnapshot {
+		public:
+			void Clear() { objects.clear(); componentTypes.clear(); componentState.clear(); }
+			bool IsEmpty() const { return objects.empty(); }
+
+			size_t GetObjectCount() const { return objects.size(); }
+
+		private:
+			friend class GameWorld;
+
+			std::vector<ObjectSnapshot> objects;
+			//type of each object's components at the time, in order
+			std::vector<ComponentTypeID> componentTypes;
+			std::vector<char> componentState;
+		};
+	}
+}
@@ -0,0 +1,78 @@
+#include "ComponentFactory.h"
+#include "LevelData.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+
+using namespace NCL;
+using namespace CSC8508;
+using namespace LevelFormat;
+
+namespace {
+	struct Registration {
+		std::string						name;
+		ComponentFactory::CreateFunction	create;
+	};
+
+	//registration runs during static initialisation, so the table is created on first use
+	std::unordered_map<uint32_t, Registration>& GetRegistrations() {
+		static std::unordered_map<uint32_t, Registration> registrations;
+		return registrations;
+	}
+}
+
+ComponentParams::ComponentParams(const LevelData& level, const ComponentRecord& component)
+	: level(level), component(component) {
+}
+
+//components have a handful of parameters, so a scan beats anything cleverer
+const ParamRecord* ComponentParams::Find(uint32_t keyHash, ParamType type) const {
+	for (uint32_t i = 0; i < component.paramCount; ++i) {
+		const ParamRecord& param = level.GetParam(component.firstParam + i);
+		if (param.keyHash == keyHash)
+			return param.type == type ? &param : nullptr;
+	}
+	return nullptr;
+}
+
+float ComponentParams::GetFloat(uint32_t keyHash, float fallback) const {
+	const ParamRecord* param = Find(keyHash, ParamNumber);
+	return param ? param->values[0] : fallback;
+}
+
+int ComponentParams::GetInt(uint32_t keyHash, int fallback) const {
+	const ParamRecord* param = Find(keyHash, ParamNumber);
+	return param ? (int)std::lround(param->values[0]) : fallback;
+}
+
+bool ComponentParams::GetBool(uint32_t keyHash, bool fallback) const {
+	const ParamRecord* param = Find(keyHash, ParamBool);
+	return param ? param->values[0] != 0.0f : fallback;
+}
+
+const char* ComponentParams::GetString(uint32_t keyHash, const char* fallback) const {
+	const ParamRecord* param = Find(keyHash, ParamString);
+	return param ? level.GetString(param->string) : fallback;
+}
+
+Maths::Vector3 ComponentParams::GetVector3(uint32_t keyHash, const Maths::Vector3& fallback) const {
+	const ParamRecord* param = Find(keyHash, ParamVector3);
+	return param ? Maths::Vector3(param->values[0], param->values[1], param->values[2]) : fallback;
+}
+
+bool ComponentFactory::Register(const char* name, CreateFunction create) {
+	auto registration = GetRegistrations().emplace(HashName(name), Registration{ name, create });
+	if (!registration.second) {
+		std::cout << "ComponentFactory: " << name << " clashes with " << registration.first->second.name << std::endl;
+		return false;
+	}
+	return true;
+}
+
+Component* ComponentFactory::AddComponent(uint32_t nameHash, GameObject* gameObject, Game* game, const ComponentParams& params) {
+	auto& registrations = GetRegistrations();
+	auto registration = registrations.find(nameHash);
+	return registration == registrations.end() ? nullptr : registration->second.create(gameObject, game, params);
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include "LevelFormat.h"
+
+#include "../../Common/Vector3.h"
+
+namespace NCL {
+	namespace CSC8508 {
+
+		class Game;
+		class GameObject;
+		class Component;
+		class LevelData;
+
+		//the parameters a level gives one component, found by the hash of their key. A getter
+		//returns its fallback when the key is missing or holds another type
+		class ComponentParams {
+		public:
+			ComponentParams(const LevelData& level, const LevelFormat::ComponentRecord& component);
+
+			float			GetFloat(uint32_t keyHash, float fallback = 0.0f) const;
+			int				GetInt(uint32_t keyHash, int fallback = 0) const;
+			bool			GetBool(uint32_t keyHash, bool fallback = false) const;
+			const char*		GetString(uint32_t keyHash, const char* fallback = "") const;
+			Maths::Vector3	GetVector3(uint32_t keyHash, const Maths::Vector3& fallback = Maths::Vector3()) const;
+
+		protected:
+			const LevelFormat::ParamRecord* Find(uint32_t keyHash, LevelFormat::ParamType type) const;
+
+			const LevelData& level;
+			const LevelFormat::ComponentRecord& component;
+		};
+
+		//components register a create function under their level name from their own source file,
+		//so adding one doesn't touch the factory. Levels create them by the name's hash
+		namespace ComponentFactory {
+			typedef Component* (*CreateFunction)(GameObject* gameObject, Game* game, const ComponentParams& params);
+
+			//returns whether the name was free, so it can initialise a static
+			bool Register(const char* name, CreateFunction create);
+
+			//nullptr if nothing is registered under the hash
+			Component* AddComponent(uint32_t nameHash, GameObject* gameObject, Game* game, const ComponentParams& params);
+		}
+	}
+}
@@ -3,11 +3,35 @@
 #include "Game.h"
 #include "PlayerComponent.h"
 #include "CameraComponent.h"
+#include "DisappearingPlatformComponent.h"
+#include "NetworkPlayerComponent.h"
+#include "RingComponent.h"
 #include "../Engine/GameWorld.h"
+#include "../Engine/TaskGraph.h"
+#include "../Engine/Profiler.h"
+#include "../Engine/AllocationTracker.h"
+#include "../../Common/GameTimer.h"
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
 
 using namespace NCL;
 using namespace CSC8508;
 
+namespace {
+	//the lookup GetComponent used to do, kept to compare the type id lookup against
+	template<typename T>
+	T* FindComponentByCast(const GameObject* object) {
+		for (auto component : object->GetComponents()) {
+			T* t = dynamic_cast<T*>(component);
+			if (t != nullptr)
+				return t;
+		}
+		return nullptr;
+	}
+}
+
 DebugState::DebugState(Game* game) {
 	this->game = game;
 	this->oldMain = nullptr;
@@ -15,6 +39,8 @@ DebugState::DebugState(Game* game) {
 }
 
 PushdownState::PushdownResult DebugState::OnUpdate(float dt, PushdownState** newState) {
+	//the selection is kept as a handle so it goes null if the object is removed
+	GameObject* selected = game->GetWorld()->GetObject(selectedObject);
 
 	if (!selectionMode) {
 		Debug::Print("Hit Q to enter selection mode", Vector2(2, 90));
@@ -25,22 +51,24 @@ PushdownState::PushdownResult DebugState::OnUpdate(float dt, PushdownState** new
 
 		if (Window::GetMouse()->ButtonPressed(NCL::MouseButtons::LEFT)) {
 
-			if (selectedObject && selectedObject->GetRenderObject()) {
-				selectedObject->GetRenderObject()->SetColour(selectedColour);
+			if (selected && selected->GetRenderObject()) {
+				selected->GetRenderObject()->SetColour(selectedColour);
 			}
 
 			const Camera& cam = (*debugCamera->GetCamera());
 			auto r = CollisionDetection::BuildRayFromMouse(cam);
 			auto object = game->Raycast(r.GetPosition(), r.GetPosition() + r.GetDirection() * 1000);
 
-			if (object) {
-				selectedObject = object;
-			}
-			else
-				selectedObject = nullptr;
+			selected = object;
+			selectedObject = object ? object->GetHandle() : GameObjectHandle();
 		}
 	}
 
+	Debug::Print("Hit B to benchmark component lookup", Vector2(2, 95));
+	Debug::Print("Hit G to print the frame task timings", Vector2(2, 85));
+	Debug::Print("Hit P to save a profile trace", Vector2(2, 80));
+	Debug::Print("Hit M to print last frame's allocations", Vector2(2, 75));
+
 	//Safety check to ensure we return the correct main camera after finishing in debug mode.
 	if (CameraComponent::GetMain() != debugCamera) {
 		oldMain = CameraComponent::GetMain();
@@ -57,22 +85,40 @@ PushdownState::PushdownResult DebugState::OnUpdate(float dt, PushdownState** new
 		return PushdownResult::Pop;
 	}
 
-	if (selectedObject) {
-		if (selectedObject->GetRenderObject() && selectedObject->GetRenderObject()->GetColour() != Debug::GREEN) {
-			selectedColour = selectedObject->GetRenderObject()->GetColour();
-			selectedObject->GetRenderObject()->SetColour(Debug::GREEN);
+	if (Window::GetKeyboard()->KeyPressed(KeyboardKeys::B)) {
+		RunComponentBenchmark();
+	}
+
+	if (Window::GetKeyboard()->KeyPressed(KeyboardKeys::G)) {
+		game->GetFrameGraph()->PrintLastTimings();
+	}
+
+	if (Window::GetKeyboard()->KeyPressed(KeyboardKeys::P)) {
+		Profiler::WriteChromeTrace("profile.json");
+	}
+
+	if (Window::GetKeyboard()->KeyPressed(KeyboardKeys::M)) {
+		AllocationTracker::PrintLastFrame();
+	}
+
+	DisplayProfile();
+
+	if (selected) {
+		if (selected->GetRenderObject() && selected->GetRenderObject()->GetColour() != Debug::GREEN) {
+			selectedColour = selected->GetRenderObject()->GetColour();
+			selected->GetRenderObject()->SetColour(Debug::GREEN);
 		}
 
 		if (Window::GetKeyboard()->KeyPressed(KeyboardKeys::K))
-			selectedObject->SetIsActive(!selectedObject->IsActive());
+			selected->SetIsActive(!selected->IsActive());
 
-		DisplayDebugInfo();
+		DisplayDebugInfo(selected);
 	}
 
 	return PushdownResult::NoChange;
 }
 
-void DebugState::DisplayDebugInfo() {
+void DebugState::DisplayDebugInfo(GameObject* selectedObject) {
 	const int maxLines = 20;
 	
 	std::vector<std::string> objectDebugInfo;
@@ -89,6 +135,71 @@ void DebugState::DisplayDebugInfo() {
 	}
 }
 
+//last frame's main thread zones, indented by depth. Worker threads are left to the trace export
+void DebugState::DisplayProfile() {
+	const int maxLines = 24;
+
+	std::stringstream frame;
+	frame << std::fixed << std::setprecision(2) << "Frame " << Profiler::GetLastFrameTime() << "ms, "
+		<< AllocationTracker::GetLastFrameAllocations() << " allocs";
+	Debug::Print(frame.str(), Vector2(55, 4));
+
+	int line = 0;
+	for (auto const& zone : Profiler::GetLastFrameSummary()) {
+		if (zone.thread != 0)
+			continue;
+		if (line == maxLines)
+			break;
+
+		std::stringstream text;
+		text << std::fixed << std::setprecision(2) << std::string(zone.depth * 2, ' ') << zone.name << " " << zone.totalMs << "ms";
+		if (zone.calls > 1)
+			text << " x" << zone.calls;
+
+		Debug::Print(text.str(), Vector2(55, 8 + 3 * line), Debug::WHITE);
+		line++;
+	}
+}
+
+//times looking up a few component types on every object in the loaded level,
+//once with the old dynamic_cast scan and once with the type id slots
+void DebugState::RunComponentBenchmark() {
+	const int iterations = 1000;
+
+	GameObjectIterator first, last;
+	game->GetWorld()->GetObjectIterators(first, last);
+	std::vector<GameObject*> objects(first, last);
+
+	int castFound = 0;
+	GameTimer timer;
+	for (int i = 0; i < iterations; i++) {
+		for (auto object : objects) {
+			castFound += FindComponentByCast<PlayerComponent>(object) != nullptr;
+			castFound += FindComponentByCast<DisappearingPlatformComponent>(object) != nullptr;
+			castFound += FindComponentByCast<RingComponent>(object) != nullptr;
+			castFound += FindComponentByCast<NetworkPlayerComponent>(object) != nullptr;
+		}
+	}
+	timer.Tick();
+	float castTime = timer.GetTimeDeltaMSec();
+
+	int idFound = 0;
+	for (int i = 0; i < iterations; i++) {
+		for (auto object : objects) {
+			idFound += object->GetComponent<PlayerComponent>() != nullptr;
+			idFound += object->GetComponent<DisappearingPlatformComponent>() != nullptr;
+			idFound += object->GetComponent<RingComponent>() != nullptr;
+			idFound += object->GetComponent<NetworkPlayerComponent>() != nullptr;
+		}
+	}
+	timer.Tick();
+	float idTime = timer.GetTimeDeltaMSec();
+
+	std::cout << "Component lookup, " << objects.size() << " objects x " << iterations << " iterations x 4 types:\n"
+		<< "  dynamic_cast scan: " << castTime << "ms (" << castFound << " found)\n"
+		<< "  type id slots:     " << idTime << "ms (" << idFound << " found)" << std::endl;
+}
+
 void DebugState::UpdateCameraControls(float dt) {
 	//Update the mouse by how much
 	float pitch = debugCamera->GetPitch() - Window::GetMouse()->GetRelativePosition().y;
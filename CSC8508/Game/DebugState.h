@@ -1,5 +1,6 @@
 #pragma once
 #include "../Engine/PushdownState.h"
+#include "../Engine/GameObjectHandle.h"
 
 #include "../../Common/Vector4.h"
 #include <vector>
@@ -23,10 +24,12 @@ namespace NCL {
 
 		private:
 			void UpdateCameraControls(float dt);
-			void DisplayDebugInfo();
+			void DisplayDebugInfo(GameObject* selectedObject);
+			void RunComponentBenchmark();
+			void DisplayProfile();
 
 			bool selectionMode;
-			GameObject* selectedObject;
+			GameObjectHandle selectedObject;
 			int debugInfoScroll;
 			Maths::Vector4 selectedColour;
 
@@ -1,6 +1,18 @@
 #include "DisappearingPlatformComponent.h"
+#include "ComponentFactory.h"
 #include "../Engine/GameObject.h"
 #include "../Engine/RenderObject.h"
+#include "../Engine/GameWorld.h"
+#include "../Engine/ComponentState.h"
+
+using namespace NCL;
+using namespace CSC8508;
+
+namespace {
+	const bool registered = ComponentFactory::Register("DisappearingPlatform", [](GameObject* object, Game*, const ComponentParams&) -> Component* {
+		return object->AddComponent<DisappearingPlatformComponent>();
+	});
+}
 
 NCL::CSC8508::DisappearingPlatformComponent::DisappearingPlatformComponent(GameObject* object) : Component("DisappearingPlatform", object)
 {
@@ -28,6 +40,21 @@ void NCL::CSC8508::DisappearingPlatformComponent::OnCollisionBegin(GameObject* o
 void NCL::CSC8508::DisappearingPlatformComponent::Disappear()
 {
 	gameObject->GetRenderObject()->SetColour(Vector4(1.f, 1.f, 1.f, 1.f) * (timer / MAX_TIMER));
-	if (timer <= 0.f)
-		gameObject->SetIsActive(false);
+	if (timer <= 0.f) {
+		//deactivating changes the physics world, which isn't safe from a worker thread
+		GameObject* object = gameObject;
+		gameObject->GetWorld()->Defer([object]() { object->SetIsActive(false); });
+	}
+}
+
+void NCL::CSC8508::DisappearingPlatformComponent::SaveState(StateWriter& state) const
+{
+	state.Write(timer);
+	state.Write(collided);
+}
+
+void NCL::CSC8508::DisappearingPlatformComponent::RestoreState(StateReader& state)
+{
+	state.Read(timer);
+	state.Read(collided);
 }
@@ -11,6 +11,11 @@ namespace NCL {
 
 			void Update(float dt) override;
 			void OnCollisionBegin(GameObject* otherObject) override;
+			void SaveState(StateWriter& state) const override;
+			void RestoreState(StateReader& state) override;
+
+			//only touches its own object, deactivating is deferred
+			bool IsThreadSafe() const override { return true; }
 
 			bool collided;
 
@@ -1,42 +1,74 @@
 #include "Game.h"
-#include "JSONLevelFactory.h"
+#include "LevelFactory.h"
 #include "GameTechRenderer.h"
 #include "IntroState.h"
+#include "HeadlessState.h"
 #include "CameraComponent.h"
 #include "LocalNetworkPlayerComponent.h"
 #include "PlayerRayFeetComponent.h"
+#include "ScoreComponent.h"
 
 #include "../Engine/GameWorld.h"
+#include "../Engine/ComponentState.h"
 #include "../Engine/Physics/PhysicsEngine/BulletWorld.h"
 #include "../Engine/NetworkManager.h"
+#include "../Engine/LevelArena.h"
+#include "../Engine/JobSystem.h"
+#include "../Engine/TaskGraph.h"
+#include "../Engine/Profiler.h"
+#include "../Engine/AllocationTracker.h"
 #include "../Engine/PushdownMachine.h"
 
 #include"../Audio/SoundManager.h"
 #include"../Audio/SoundInstance.h"
 
 #include "../../Plugins/OpenGLRendering/OGLResourceManager.h"
+#include "../../Common/HeadlessResourceManager.h"
 
 
 using namespace NCL;
 using namespace CSC8508;
 using namespace Maths;
 
-Game::Game() {
-	resourceManager = new OGLResourceManager();
+Game::Game(const GameSettings& settings) {
+	this->settings = settings;
+	JobSystem::Init();
 	world = new GameWorld();
-	renderer = new GameTechRenderer(*world, *resourceManager);
+	if (settings.headless) {
+		resourceManager = new HeadlessResourceManager();
+		renderer = nullptr;
+	}
+	else {
+		resourceManager = new OGLResourceManager();
+		renderer = new GameTechRenderer(*world, *resourceManager);
+	}
 	physics		= new physics::BulletWorld();
-	gameStateMachine = new PushdownMachine(new IntroState(this));
-	//networkManager = new NetworkManager();
+	physics->setGameWorld(world);
+	levelStartPhysics = new physics::PhysicsSnapshot();
+	levelStartWorld = new WorldSnapshot();
+	if (settings.headless)
+		gameStateMachine = new PushdownMachine(new HeadlessState(this));
+	else
+		gameStateMachine = new PushdownMachine(new IntroState(this));
+	networkManager = nullptr;
+	music = nullptr;
 
 	forceMagnitude = 10.0f;
 	useGravity = false;
 	inSelectionMode = false;	
+	paused = false;
+	frameDt = 0.0f;
+	BuildFrameGraph();
 
 	Debug::SetRenderer(renderer);
-	Audio::SoundManager::Init();
+	//headless games leave the sound manager uninitialised, which turns every sound into a no-op
+	if (!settings.headless)
+		Audio::SoundManager::Init();
 	InitialiseAssets();
 
+	if (settings.headless)
+		return;
+
 	//Play Background Music
 	music = new Audio::SoundInstance();
 	music->SetVolume(0.2f);
@@ -59,15 +91,27 @@ Game::~Game()	{
 	delete resourceManager;
 	delete networkManager;
 	delete physics;
+	delete levelStartPhysics;
+	delete levelStartWorld;
 	delete renderer;
 	delete world;
 	delete music;
+	delete frameGraph;
+	JobSystem::Shutdown();
 }
 
 bool Game::UpdateGame(float dt) {
-
-	if (gameStateMachine->Update(dt) == false)
-		return false;
+	//summarises everything recorded since the last call, which is the whole of the previous frame
+	Profiler::EndFrame();
+	AllocationTracker::EndFrame();
+	PROFILE_SCOPE("Game::UpdateGame");
+
+	{
+		PROFILE_SCOPE("StateMachine");
+		ALLOC_SCOPE(AllocTag::States);
+		if (gameStateMachine->Update(dt) == false)
+			return false;
+	}
 
 	
 	//if (Window::GetKeyboard()->KeyPressed(KeyboardKeys::K)) {
@@ -75,23 +119,83 @@ bool Game::UpdateGame(float dt) {
 	//}
 
 	UpdateKeys();
-	
-	if (!paused) {
-		physics->Update(dt);
 
-		world->UpdateWorld(dt);
-	}
-
-	UpdateKeys();
-	renderer->Update(dt);
+	frameDt = dt;
+	frameGraph->Run();
+	return true;
+}
 
-	if(networkManager)
-		networkManager->Update(dt);
+//the rest of the frame after the state machine. Physics and the world update run game code that
+//can touch the window or GL resources, so they stay on the main thread along with rendering.
+//Once the world has updated, animation, building the render list, flushing transforms, networking
+//and audio don't depend on each other and run alongside each other. Headless games have no render
+//list to build and their render task only throws the debug queues away
+void Game::BuildFrameGraph() {
+	frameGraph = new TaskGraph();
+
+	TaskID physicsTask = frameGraph->AddTask("Physics", [this]() {
+		if (!paused)
+			physics->Update(frameDt);
+	}, true);
+
+	TaskID worldTask = frameGraph->AddTask("World", [this]() {
+		if (!paused)
+			world->UpdateSimulation(frameDt);
+		UpdateKeys();
+	}, true);
+
+	TaskID animationTask = frameGraph->AddTask("Animation", [this]() {
+		if (!paused)
+			world->UpdateObjects(frameDt);
+	});
+
+	TaskID renderListTask = -1;
+	if (renderer) {
+		renderListTask = frameGraph->AddTask("RenderList", [this]() {
+			renderer->BuildRenderList();
+		});
+	}
 
-	Debug::FlushRenderables(dt);
-	renderer->Render();
-	Audio::SoundManager::Update();
-	return true;
+	//matrices are only rebuilt here, after everything this frame has moved. Child bodies are
+	//moved into place by the flush, so it stays on the main thread with the rest of bullet
+	TaskID transformTask = frameGraph->AddTask("Transforms", []() {
+		Transform::FlushDirtyTransforms();
+	}, true);
+
+	//packets turn into object and body changes, so they're handled on the main thread before
+	//anything else walks the world
+	TaskID networkTask = frameGraph->AddTask("Network", [this]() {
+		if (networkManager)
+			networkManager->Update(frameDt);
+	}, true);
+
+	TaskID audioTask = frameGraph->AddTask("Audio", []() {
+		Audio::SoundManager::Update();
+	});
+
+	TaskID renderTask = frameGraph->AddTask("Render", [this]() {
+		if (renderer)
+			renderer->Update(frameDt);
+		Debug::FlushRenderables(frameDt);
+		if (renderer)
+			renderer->Render();
+	}, true);
+
+	frameGraph->AddDependency(worldTask, physicsTask);
+	frameGraph->AddDependency(animationTask, worldTask);
+	frameGraph->AddDependency(networkTask, worldTask);
+	frameGraph->AddDependency(animationTask, networkTask);
+	frameGraph->AddDependency(transformTask, networkTask);
+	frameGraph->AddDependency(transformTask, animationTask);
+	frameGraph->AddDependency(audioTask, worldTask);
+	frameGraph->AddDependency(transformTask, worldTask);
+	frameGraph->AddDependency(renderTask, animationTask);
+	frameGraph->AddDependency(renderTask, transformTask);
+
+	if (renderListTask != -1) {
+		frameGraph->AddDependency(renderListTask, worldTask);
+		frameGraph->AddDependency(renderTask, renderListTask);
+	}
 }
 
 void Game::EnableNetworking(bool client) {
@@ -123,6 +227,11 @@ bool NCL::CSC8508::Game::IsMajorityPlayersFinished()
 }
 
 
+void Game::DrawString(const std::string& text, const Vector2& pos, const Vector4& colour, float size) {
+	if (renderer)
+		renderer->DrawString(text, pos, colour, size);
+}
+
 GameObject* Game::Raycast(const Vector3& from, const Vector3& to) const {
 	return physics->rayIntersect(from, to, Vector3());
 }
@@ -188,8 +297,11 @@ void Game::Clear(bool force) {
 	Audio::SoundManager::Update();
 }
 
+//everything the level creates while loading goes into one arena, which is released in one go
+//once the last of those objects has been deleted
 void Game::InitFromJSON(std::string fileName) {
-	JSONLevelFactory::ReadLevelFromJson(fileName, this);
+	LevelArenaScope arena;
+	LevelFactory::LoadLevel(fileName, this);
 }
 
 void Game::InitNetworkPlayers()
@@ -225,7 +337,10 @@ bool NCL::CSC8508::Game::IsExitLobbyTime()
 {
 	if (networkManager->IsClient())
 		return networkManager->IsExitLobbyTime();
-	if (Window::GetKeyboard()->KeyPressed(KeyboardKeys::K)) {
+	//nobody to press K on a dedicated server, it starts as soon as enough players are in
+	bool start = settings.headless ? (int)networkManager->GetPlayerLobby()->size() >= settings.serverPlayers
+		: Window::GetKeyboard()->KeyPressed(KeyboardKeys::K);
+	if (start) {
 		networkManager->ActivateExitLobby();
 		return true;
 	}
@@ -233,18 +348,75 @@ bool NCL::CSC8508::Game::IsExitLobbyTime()
 }
 
 void Game::InitWorld(std::string levelName, bool forceClear) {
+	ALLOC_SCOPE(AllocTag::Level);
+	GameTimer loadTimer;
+	if (!forceClear && levelName == loadedLevel && RestartLevel()) {
+		loadTimer.Tick();
+		std::cout << "Level " << levelName << " restarted in " << loadTimer.GetTimeDeltaMSec() << "ms ("
+			<< levelStartWorld->GetObjectCount() << " objects)" << std::endl;
+		Window::TickTimer();
+		return;
+	}
+
 	Clear(forceClear);
+	loadTimer.Tick();
+	float clearTime = loadTimer.GetTimeDeltaMSec();
 
 	InitCamera();
 
 	InitFromJSON(levelName);
+	loadTimer.Tick();
+
+	const LevelArena::Stats& arenaStats = LevelArena::GetLastLevelStats();
+	std::cout << "Level " << levelName << " cleared in " << clearTime << "ms, loaded in "
+		<< loadTimer.GetTimeDeltaMSec() << "ms (" << physics->getBodyCount() << " bodies)" << std::endl;
+	std::cout << "  Level arena: " << arenaStats.allocations << " allocations, " << arenaStats.bytes / 1024 << "KB in "
+		<< arenaStats.blocks << " blocks, " << LevelArena::GetLiveArenaCount() - 1 << " earlier arenas still alive" << std::endl;
+
+	world->CaptureSnapshot(*levelStartWorld);
+	physics->captureSnapshot(*levelStartPhysics);
+	levelStartScore.clear();
+	if (ScoreComponent::instance) {
+		StateWriter writer(levelStartScore);
+		ScoreComponent::instance->SaveState(writer);
+	}
+	loadedLevel = levelName;
 
 	//Tick the timer so that the load time isn't factored into any time related calculations
 	Window::TickTimer();
 }
 
+//the level's objects are still in the world, so they are put back rather than loaded again
+bool Game::RestartLevel() {
+	PROFILE_SCOPE("Game::RestartLevel");
+	if (levelStartWorld->IsEmpty() || !world->RestoreSnapshot(*levelStartWorld))
+		return false;
+
+	physics->restoreSnapshot(*levelStartPhysics);
+
+	if (ScoreComponent::instance) {
+		if (levelStartScore.empty())
+			ScoreComponent::instance->Reset();
+		else {
+			StateReader reader(levelStartScore.data());
+			ScoreComponent::instance->RestoreState(reader);
+		}
+	}
+
+	Audio::SoundManager::Update();
+	return true;
+}
+
+void Game::ResetLevelPhysics() {
+	physics->restoreSnapshot(*levelStartPhysics);
+}
+
 void Game::InitIntroWorld() {
 	Clear(true);
+	levelStartPhysics->clear();
+	levelStartWorld->Clear();
+	levelStartScore.clear();
+	loadedLevel.clear();
 	InitIntroCamera();
 }
 
@@ -1,8 +1,10 @@
 #pragma once
+#include "../../Common/Vector2.h"
 #include "../../Common/Vector3.h"
 #include "../../Common/Vector4.h"
 
 #include <string>
+#include <vector>
 
 namespace NCL {
 
@@ -18,30 +20,50 @@ namespace NCL {
 
 		namespace physics {
 			class BulletWorld;
+			class PhysicsSnapshot;
 		}
 
 		class GameTechRenderer;
 		class PhysicsSystem;
 		class GameWorld;
+		class WorldSnapshot;
 		class GameObject;
 		class PushdownMachine;
 		class NetworkManager;
+		class TaskGraph;
+
+		//how the game is started, the defaults are the normal windowed game with menus
+		struct GameSettings {
+			//no renderer, audio or real input. Needs a headless window rather than a game window
+			bool headless = false;
+			//headless only: host matches instead of playing a single level
+			bool server = false;
+			//index of the level a headless run plays, or the first level of each networked match
+			int level = 0;
+			//headless only: remote players a server waits for before leaving the lobby
+			int serverPlayers = 1;
+		};
 
 		class Game		{
 		public:
-			Game();
+			Game(const GameSettings& settings = GameSettings());
 			~Game();
 
+			//loading the level that is already loaded restarts it in place instead, unless forceClear is set
 			void InitWorld(std::string levelName, bool forceClear = false);
 			void InitIntroWorld();
 			void InitNetworkPlayers();
 			bool IsExitLobbyTime();
+			//puts every body back where it was when the level finished loading
+			void ResetLevelPhysics();
 
 			void EnableNetworking(bool client);
 			void DisableNetworking();
 			bool IsAllPlayersFinished(); 
 			bool IsMajorityPlayersFinished();
 			bool IsNetworkGame() { return networkManager != nullptr; }
+			bool IsHeadless() const { return settings.headless; }
+			const GameSettings& GetSettings() const { return settings; }
 			
 			virtual bool UpdateGame(float dt);
 
@@ -66,7 +88,11 @@ namespace NCL {
 			GameWorld* GetWorld() const { return world; }
 			physics::BulletWorld* GetPhysics() const { return physics; }
 
+			//null when headless
 			GameTechRenderer* getRenderer() { return renderer; }
+			//draws through the renderer, if there is one
+			void DrawString(const std::string& text, const Maths::Vector2& pos, const Maths::Vector4& colour, float size);
+			const TaskGraph* GetFrameGraph() const { return frameGraph; }
 
 			NCL::Rendering::ResourceManager* GetResourceManager() { return resourceManager; }
 
@@ -81,23 +107,35 @@ namespace NCL {
 
 			void InitCamera();
 			void UpdateKeys();
+			void BuildFrameGraph();
 						
 			void InitFromJSON(std::string fileName);
+			bool RestartLevel();
 
 
 			GameTechRenderer*	renderer;
 			GameWorld*			world;
 			NCL::Rendering::ResourceManager* resourceManager;
 			physics::BulletWorld* physics;
+			physics::PhysicsSnapshot* levelStartPhysics;
+			WorldSnapshot* levelStartWorld;
+			//the score is on a persistent object the world snapshot skips, empty if it didn't exist yet
+			std::vector<char> levelStartScore;
+			//the level both snapshots belong to, empty when there isn't one
+			std::string loadedLevel;
 			PushdownMachine* gameStateMachine;
 			NetworkManager* networkManager;
 			Audio::SoundInstance* music;
+			TaskGraph* frameGraph;
+			GameSettings settings;
 
 			bool useGravity;
 			bool inSelectionMode;
 			bool paused;
 
 			float	forceMagnitude;
+			//dt of the frame the graph is running
+			float	frameDt;
 		
 			std::string name;
 			Maths::Vector4 saveColor = Maths::Vector4(1, 1, 1, 1);
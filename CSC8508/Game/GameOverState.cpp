@@ -36,8 +36,8 @@ PushdownState::PushdownResult GameOverState::OnUpdate(float dt, PushdownState**
 	
 	std::string completeString = isFinal ? "Game Completed!" : "Level Complete";
 
-	game->getRenderer()->DrawString(completeString, Vector2(38, 10), Vector4(1.0f, 1.0f, 1.0f, 0.0f), 20.0f);
-	game->getRenderer()->DrawString("Press R to return to Menu", Vector2(34, 99), Vector4(1.0f, 1.0f, 1.0f, 1.0f), 15.0f);
+	game->DrawString(completeString, Vector2(38, 10), Vector4(1.0f, 1.0f, 1.0f, 0.0f), 20.0f);
+	game->DrawString("Press R to return to Menu", Vector2(34, 99), Vector4(1.0f, 1.0f, 1.0f, 1.0f), 15.0f);
 
 	if (isFinal)
 		return PushdownResult::NoChange;
@@ -49,17 +49,17 @@ PushdownState::PushdownResult GameOverState::OnUpdate(float dt, PushdownState**
 		if (allFinished)
 		{
 			timer -= dt;
-			game->getRenderer()->DrawString("Next Level: " + std::to_string((int)timer), Vector2(43, 95), Vector4(1.0f, 1.0f, 1.0f, 1.0f), 15.0f);
+			game->DrawString("Next Level: " + std::to_string((int)timer), Vector2(43, 95), Vector4(1.0f, 1.0f, 1.0f, 1.0f), 15.0f);
 		}
 		else
-			game->getRenderer()->DrawString("Waiting for other players!", Vector2(35, 95), Vector4(1.0f, 1.0f, 1.0f, 1.0f), 15.0f);
+			game->DrawString("Waiting for other players!", Vector2(35, 95), Vector4(1.0f, 1.0f, 1.0f, 1.0f), 15.0f);
 
 		if (timer <= 0.0f) 
 				return PushdownResult::Pop;
 	}
 	else
 	{
-		game->getRenderer()->DrawString("Press N to go to Next Level! " + (int)timer, Vector2(35, 95), Vector4(1.0f, 1.0f, 1.0f, 1.0f), 15.0f);
+		game->DrawString("Press N to go to Next Level! " + (int)timer, Vector2(35, 95), Vector4(1.0f, 1.0f, 1.0f, 1.0f), 15.0f);
 		if (Window::GetKeyboard()->KeyDown(KeyboardKeys::N)) return PushdownResult::Pop;
 	}
 
@@ -1,13 +1,21 @@
 #define NOMINMAX
 #include "GameStateManagerComponent.h"
+#include "ComponentFactory.h"
 #include "Game.h"
 #include "ScoreComponent.h"
 #include "GameTechRenderer.h"
 #include "../Engine/GameObject.h"
+#include "../Engine/ComponentState.h"
 
 using namespace NCL;
 using namespace CSC8508;
 
+namespace {
+	const bool registered = ComponentFactory::Register("GameStateManager", [](GameObject* object, Game* game, const ComponentParams&) -> Component* {
+		return object->AddComponent<GameStateManagerComponent>(game);
+	});
+}
+
 
 GameStateManagerComponent* GameStateManagerComponent::instance = nullptr;
 
@@ -19,7 +27,10 @@ GameStateManagerComponent::GameStateManagerComponent(GameObject* object, Game* g
 		instance = this;
 
 	this->game = game;
+	isPlayerFinished = false;
 	isGameFinished = false;
+	majorityFinished = false;
+	finishTimer = 0.0f;
 	levelID = 0;
 }
 
@@ -47,7 +58,7 @@ void NCL::CSC8508::GameStateManagerComponent::Update(float dt) {
 		if (majorityFinished)
 		{
 			finishTimer = std::max(0.0f, finishTimer - dt);
-			if (!isGameFinished) game->getRenderer()->DrawString("Time remaining: " + std::to_string((int)finishTimer), Vector2(79, 90), Vector4(1.0f, 1.0f, 1.0f, 1.0f), 12.0f);
+			if (!isGameFinished) game->DrawString("Time remaining: " + std::to_string((int)finishTimer), Vector2(79, 90), Vector4(1.0f, 1.0f, 1.0f, 1.0f), 12.0f);
 			if (finishTimer <= 0.0f)
 				isGameFinished = true;
 		}
@@ -59,5 +70,23 @@ void NCL::CSC8508::GameStateManagerComponent::Update(float dt) {
 		isGameFinished = isGameFinished || isPlayerFinished;
 
 	int score = ScoreComponent::instance ? ScoreComponent::instance->GetScore() : 0;
-	if(!isGameFinished) game->getRenderer()->DrawString("Score: " + std::to_string(score), Vector2(85, 95), Vector4(1.0f, 1.0f, 1.0f, 1.0f), 12.0f);
+	if(!isGameFinished) game->DrawString("Score: " + std::to_string(score), Vector2(85, 95), Vector4(1.0f, 1.0f, 1.0f, 1.0f), 12.0f);
+}
+
+void GameStateManagerComponent::SaveState(StateWriter& state) const
+{
+	state.Write(isPlayerFinished);
+	state.Write(isGameFinished);
+	state.Write(majorityFinished);
+	state.Write(finishTimer);
+	state.Write(levelID);
+}
+
+void GameStateManagerComponent::RestoreState(StateReader& state)
+{
+	state.Read(isPlayerFinished);
+	state.Read(isGameFinished);
+	state.Read(majorityFinished);
+	state.Read(finishTimer);
+	state.Read(levelID);
 }
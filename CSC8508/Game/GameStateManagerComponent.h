@@ -17,6 +17,8 @@ namespace NCL {
 				~GameStateManagerComponent();
 				void Start();
 				void Update(float dt);
+				void SaveState(StateWriter& state) const override;
+				void RestoreState(StateReader& state) override;
 				void SetPlayerFinished(bool val) { isPlayerFinished = val; }
 				void SetLevelID(int val) { levelID = val; }
 				bool IsGameFinished() const { return isGameFinished; }
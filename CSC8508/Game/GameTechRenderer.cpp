@@ -20,6 +20,8 @@
 #include "PointLight.h"
 #include "SpotLight.h"
 #include "Shadow.h"
+#include "../Engine/Profiler.h"
+#include "../Engine/AllocationTracker.h"
 
 using namespace NCL;
 using namespace Rendering;
@@ -163,9 +165,22 @@ void GameTechRenderer::LoadSkybox() {
 }
 
 
-void GameTechRenderer::RenderFrame() {
+void GameTechRenderer::BuildRenderList() {
+	PROFILE_SCOPE("Renderer::BuildRenderList");
+	ALLOC_SCOPE(AllocTag::Render);
 	BuildObjectList();
 	SortObjectList();
+	renderListReady = true;
+}
+
+void GameTechRenderer::RenderFrame() {
+	PROFILE_SCOPE("Renderer::RenderFrame");
+	ALLOC_SCOPE(AllocTag::Render);
+	if (!renderListReady) {
+		BuildObjectList();
+		SortObjectList();
+	}
+	renderListReady = false;
 
 	if (CameraComponent::GetMain() == nullptr)
 		return;
@@ -225,6 +240,7 @@ void GameTechRenderer::SortObjectList() {
 }
 
 void GameTechRenderer::RenderShadowMap() {
+	PROFILE_SCOPE("Renderer::ShadowMap");
 	glDisable(GL_BLEND);
 	glEnable(GL_DEPTH_TEST);
 
@@ -255,7 +271,7 @@ void GameTechRenderer::RenderShadowMap() {
 				glUniform1i(glGetUniformLocation(depthCubemapShader->GetProgramID(), "hasJoints"), false);
 			}
 
-			Matrix4 modelMatrix = (*i).GetTransform()->GetMatrix();
+			Matrix4 modelMatrix = (*i).GetTransform()->GetRenderMatrix();
 			glUniformMatrix4fv(modelLocation, 1, false, (float*)&modelMatrix);
 
 			int layerCount = (*i).GetMesh()->GetSubMeshCount();
@@ -303,6 +319,7 @@ void GameTechRenderer::RenderShadowMap() {
 }
 
 void GameTechRenderer::RenderSkybox() {
+	PROFILE_SCOPE("Renderer::Skybox");
 	glDisable(GL_CULL_FACE);
 	glDisable(GL_BLEND);
 	glDisable(GL_DEPTH_TEST);
@@ -334,6 +351,7 @@ void GameTechRenderer::RenderSkybox() {
 }
 
 void GameTechRenderer::RenderCamera() {
+	PROFILE_SCOPE("Renderer::Camera");
 	glViewport(0, 0, currentWidth, currentHeight);
 	float screenAspect = (float)currentWidth / (float)currentHeight;
 	Matrix4 viewMatrix = CameraComponent::GetMain()->GetCamera()->BuildViewMatrix();
@@ -396,7 +414,7 @@ void GameTechRenderer::RenderCamera() {
 	//	glUniform1i(shadowTexLocation, 1);
 
 
-		Matrix4 modelMatrix = (*i).GetTransform()->GetMatrix();
+		Matrix4 modelMatrix = (*i).GetTransform()->GetRenderMatrix();
 		glUniformMatrix4fv(modelLocation, 1, false, (float*)&modelMatrix);
 
 		//	Matrix4 fullShadowMat = shadowMatrix * modelMatrix;
@@ -32,6 +32,9 @@ namespace NCL {
 			~GameTechRenderer();
 
 			OGLShader* getTempShader() { return m_temp_shader; }
+
+			//builds the list of objects to draw ahead of Render, so it can be done off the main thread
+			void BuildRenderList();
 			//NCL::Rendering::ResourceManager* GetResourceManager() { return resourceManager; }
 		protected:
 			void RenderFrame()	override;
@@ -56,6 +59,7 @@ namespace NCL {
 			void LoadSkybox();
 			//NCL::Rendering::ResourceManager* resourceManager;
 			std::vector<const RenderObject*> activeObjects;
+			bool renderListReady = false;
 
 			OGLShader*	skyboxShader;
 			OGLMesh*	skyboxMesh;
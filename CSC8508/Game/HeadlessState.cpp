@@ -0,0 +1,26 @@
+#include "HeadlessState.h"
+#include "LobbyState.h"
+#include "PlayState.h"
+#include "Game.h"
+
+using namespace NCL;
+using namespace CSC8508;
+
+HeadlessState::HeadlessState(Game* game) {
+	this->game = game;
+	started = false;
+}
+
+PushdownState::PushdownResult HeadlessState::OnUpdate(float dt, PushdownState** newState) {
+	const GameSettings& settings = game->GetSettings();
+
+	if (started && !settings.server)
+		return PushdownResult::Pop;
+
+	started = true;
+	if (settings.server)
+		*newState = new LobbyState(game, false);
+	else
+		*newState = new PlayState(game, false, settings.level);
+	return PushdownResult::Push;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "../Engine/PushdownState.h"
+
+namespace NCL {
+	namespace CSC8508 {
+
+		class Game;
+
+		//stands in for the menus when there is nobody to click them. A server goes back into the
+		//lobby every time a match ends, a single level run is over once its level is left
+		class HeadlessState : public PushdownState {
+
+			PushdownResult OnUpdate(float dt, PushdownState** newState) override;
+
+		public:
+			HeadlessState(Game* game);
+
+		protected:
+			Game* game;
+			bool started;
+		};
+	}
+}
@@ -1,5 +1,7 @@
 #pragma once
 #include"HingeComponent.h"
+#include"ComponentFactory.h"
+#include"../Engine/GameObject.h"
 #include"Game.h"
 
 #include"../Engine/Physics/PhysicsEngine/BulletWorld.h"
@@ -7,6 +9,12 @@
 using namespace NCL;
 using namespace CSC8508;
 
+namespace {
+	const bool registered = ComponentFactory::Register("HingeComponent", [](GameObject* object, Game* game, const ComponentParams& params) -> Component* {
+		return object->AddComponent<HingeComponent>(game, params.GetVector3(LevelFormat::HashName("point")), params.GetVector3(LevelFormat::HashName("axis")));
+	});
+}
+
 HingeComponent::HingeComponent(GameObject* object, Game* game, Maths::Vector3 point, Maths::Vector3 axis)
 	:Component("HingeComponent", object)
 {
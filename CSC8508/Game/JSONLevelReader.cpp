@@ -0,0 +1,577 @@
+#include "JSONLevelReader.h"
+#include "LevelData.h"
+
+#include "../../Plugins/json/json.hpp"
+#include "../../Common/Assets.h"
+#include "../../Common/MappedFile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+using namespace NCL;
+using namespace CSC8508;
+using namespace LevelFormat;
+
+using json = nlohmann::json;
+
+namespace {
+	//what the parser is inside of
+	enum class Scope {
+		File,
+		Prefabs,
+		Level,
+		Object,
+		Transform,
+		Vector,
+		Physics,
+		Collider,
+		Render,
+		Components,
+		Component,
+		Skipped
+	};
+
+	//what the last key named, so values can go straight into their record
+	enum class Field {
+		None,
+		Prefabs, Objects,
+		Name, Tag, Parent, Prefab, IsStatic, Transform, Physics, Collider, Render, Components,
+		Position, Orientation, Scale,
+		Axis,
+		Mass, IsKinematic,
+		Type, Radius, Height, IsTrigger,
+		Mesh, Material, Texture, Animation, RenderScale,
+		ComponentName, ComponentParam
+	};
+
+	//parts of an object that an instance sets itself rather than taking from its prefab
+	enum Override : uint32_t {
+		OverrideName		= 1 << 0,
+		OverrideTag			= 1 << 1,
+		OverrideParent		= 1 << 2,
+		OverrideStatic		= 1 << 3,
+		OverridePosition	= 1 << 4,
+		OverrideOrientation	= 1 << 5,
+		OverrideScale		= 1 << 6,
+		OverridePhysics		= 1 << 7,
+		OverrideCollider	= 1 << 8,
+		OverrideRender		= 1 << 9,
+		OverrideComponents	= 1 << 10
+	};
+
+	//a prefab is kept as read, before physics and render are settled, so instances can replace
+	//any of its blocks
+	struct Prefab {
+		ObjectRecord	record;
+		bool			hasPhysics;
+		bool			hasRender;
+		bool			kinematic;
+	};
+
+	//nlohmann's sax interface. Strings arrive as references into the parser's own buffer and are
+	//only copied into the level's string table, so nothing but the records is kept
+	class LevelHandler {
+	public:
+		LevelHandler(LevelData& level) : level(level) {
+			scopes.reserve(16);
+			field		= Field::None;
+			record		= nullptr;
+			component	= nullptr;
+			vector		= nullptr;
+			vectorSize	= 0;
+			axis		= 0;
+			paramKey	= NO_STRING;
+			paramHash	= 0;
+			prefab		= NO_STRING;
+			overrides	= 0;
+			hasPhysics	= false;
+			hasRender	= false;
+			kinematic	= false;
+			definingPrefab	= false;
+			foundObjects	= false;
+		}
+
+		//a file is either an array of objects or an object holding prefabs and then objects
+		bool FoundObjects() const {
+			return foundObjects;
+		}
+
+		bool null() {
+			if (IsReadingValues() && field == Field::ComponentParam)
+				SkipParam();
+			return !scopes.empty();
+		}
+
+		bool boolean(bool value) {
+			if (!IsReadingValues())
+				return !scopes.empty();
+
+			switch (field) {
+			case Field::IsStatic:		SetFlag(IsStatic, value); break;
+			case Field::IsKinematic:	kinematic = value; break;
+			case Field::IsTrigger:		SetFlag(IsTrigger, value); break;
+			case Field::ComponentParam:	AddParam(ParamBool, value ? 1.0f : 0.0f); break;
+			default: break;
+			}
+			return true;
+		}
+
+		bool number_integer(json::number_integer_t value)						{ return Number((float)value); }
+		bool number_unsigned(json::number_unsigned_t value)						{ return Number((float)value); }
+		bool number_float(json::number_float_t value, const json::string_t&)	{ return Number((float)value); }
+
+		bool string(json::string_t& value) {
+			if (!IsReadingValues())
+				return !scopes.empty();
+
+			switch (field) {
+			case Field::Name:		record->name = level.AddString(value); break;
+			case Field::Tag:		record->tag = level.AddString(value); break;
+			case Field::Parent:		record->parent = level.AddString(value); break;
+			case Field::Prefab:		prefab = level.AddString(value); break;
+			case Field::Mesh:		record->mesh = level.AddString(value); break;
+			case Field::Material:	record->material = level.AddString(value); break;
+			case Field::Texture:	record->texture = level.AddString(value); break;
+			case Field::Animation:	record->animation = level.AddString(value); break;
+			case Field::Type:
+				if (value == "box")
+					record->collider = ColliderBox;
+				else if (value == "sphere")
+					record->collider = ColliderSphere;
+				else if (value == "capsule")
+					record->collider = ColliderCapsule;
+				break;
+			case Field::ComponentName:
+				component->name = level.AddString(value);
+				component->nameHash = HashName(value.c_str());
+				break;
+			case Field::ComponentParam:
+				AddParam(ParamString, 0.0f).string = level.AddString(value);
+				break;
+			default: break;
+			}
+			return true;
+		}
+
+		bool binary(json::binary_t&) {
+			return true;
+		}
+
+		bool key(json::string_t& value) {
+			field = Field::None;
+
+			switch (scopes.back()) {
+			case Scope::File:
+				if (value == "prefabs")			field = Field::Prefabs;
+				else if (value == "objects")	field = Field::Objects;
+				break;
+			case Scope::Object:
+				if (value == "name")			Select(Field::Name, OverrideName);
+				else if (value == "tag")		Select(Field::Tag, OverrideTag);
+				else if (value == "parent")		Select(Field::Parent, OverrideParent);
+				else if (value == "prefab")		field = Field::Prefab;
+				else if (value == "isStatic")	Select(Field::IsStatic, OverrideStatic);
+				else if (value == "transform")	field = Field::Transform;
+				else if (value == "physics")	Select(Field::Physics, OverridePhysics);
+				else if (value == "collider")	Select(Field::Collider, OverrideCollider);
+				else if (value == "render")		Select(Field::Render, OverrideRender);
+				else if (value == "components")	Select(Field::Components, OverrideComponents);
+				break;
+			case Scope::Transform:
+				if (value == "position")			Select(Field::Position, OverridePosition);
+				else if (value == "orientation")	Select(Field::Orientation, OverrideOrientation);
+				else if (value == "scale")			Select(Field::Scale, OverrideScale);
+				break;
+			case Scope::Vector:
+				if (value.size() == 1 && value[0] >= 'w' && value[0] <= 'z') {
+					//x, y, z then w
+					axis = value[0] == 'w' ? 3 : value[0] - 'x';
+					field = axis < vectorSize ? Field::Axis : Field::None;
+				}
+				break;
+			case Scope::Physics:
+				if (value == "mass")				field = Field::Mass;
+				else if (value == "isKinematic")	field = Field::IsKinematic;
+				break;
+			case Scope::Collider:
+				if (value == "type")			field = Field::Type;
+				else if (value == "radius")		field = Field::Radius;
+				else if (value == "height")		field = Field::Height;
+				else if (value == "isTrigger")	field = Field::IsTrigger;
+				break;
+			case Scope::Render:
+				if (value == "mesh")				field = Field::Mesh;
+				else if (value == "material")		field = Field::Material;
+				else if (value == "texture")		field = Field::Texture;
+				else if (value == "animation")		field = Field::Animation;
+				else if (value == "renderScale")	field = Field::RenderScale;
+				break;
+			case Scope::Component:
+				if (value == "name")
+					field = Field::ComponentName;
+				else {
+					field = Field::ComponentParam;
+					paramKey = level.AddString(value);
+					paramHash = HashName(value.c_str());
+				}
+				break;
+			default: break;
+			}
+			return true;
+		}
+
+		bool start_object(std::size_t) {
+			if (scopes.empty()) {
+				scopes.push_back(Scope::File);
+				return true;
+			}
+
+			switch (scopes.back()) {
+			case Scope::Level:
+			case Scope::Prefabs:
+				BeginObject(scopes.back() == Scope::Prefabs);
+				scopes.push_back(Scope::Object);
+				return true;
+			case Scope::Components:
+				BeginComponent();
+				scopes.push_back(Scope::Component);
+				return true;
+			case Scope::Object:
+				if (field == Field::Transform) {
+					scopes.push_back(Scope::Transform);
+					return true;
+				}
+				if (field == Field::Physics) {
+					hasPhysics = true;
+					scopes.push_back(Scope::Physics);
+					return true;
+				}
+				if (field == Field::Collider) {
+					scopes.push_back(Scope::Collider);
+					return true;
+				}
+				if (field == Field::Render) {
+					hasRender = true;
+					scopes.push_back(Scope::Render);
+					return true;
+				}
+				break;
+			case Scope::Transform:
+				if (field == Field::Position)
+					return BeginVector(record->position, 3);
+				if (field == Field::Orientation)
+					return BeginVector(record->orientation, 4);
+				if (field == Field::Scale)
+					return BeginVector(record->scale, 3);
+				break;
+			case Scope::Component:
+				if (field == Field::ComponentParam)
+					return BeginVector(AddParam(ParamVector3, 0.0f).values, 3);
+				break;
+			default: break;
+			}
+
+			scopes.push_back(Scope::Skipped);
+			return true;
+		}
+
+		bool end_object() {
+			Scope ended = scopes.back();
+			scopes.pop_back();
+
+			if (ended == Scope::Object)
+				EndObject();
+			else if (ended == Scope::Component)
+				EndComponent();
+			return true;
+		}
+
+		bool start_array(std::size_t) {
+			if (scopes.empty()) {
+				foundObjects = true;
+				scopes.push_back(Scope::Level);
+			}
+			else if (scopes.back() == Scope::File && field == Field::Prefabs)
+				scopes.push_back(Scope::Prefabs);
+			else if (scopes.back() == Scope::File && field == Field::Objects) {
+				foundObjects = true;
+				scopes.push_back(Scope::Level);
+			}
+			else if (scopes.back() == Scope::Object && field == Field::Components)
+				scopes.push_back(Scope::Components);
+			else {
+				if (scopes.back() == Scope::Component && field == Field::ComponentParam)
+					SkipParam();
+				scopes.push_back(Scope::Skipped);
+			}
+			return true;
+		}
+
+		bool end_array() {
+			scopes.pop_back();
+			return true;
+		}
+
+		bool parse_error(std::size_t position, const std::string&, const nlohmann::detail::exception& error) {
+			std::cout << "Level json error at byte " << position << ": " << error.what() << std::endl;
+			return false;
+		}
+
+	protected:
+		//scalars only mean something directly inside an object we read
+		bool IsReadingValues() const {
+			if (scopes.empty())
+				return false;
+			Scope scope = scopes.back();
+			return scope != Scope::File && scope != Scope::Prefabs && scope != Scope::Level
+				&& scope != Scope::Components && scope != Scope::Skipped;
+		}
+
+		void Select(Field selected, uint32_t overrideFlag) {
+			field = selected;
+			overrides |= overrideFlag;
+		}
+
+		bool Number(float value) {
+			if (!IsReadingValues())
+				return !scopes.empty();
+
+			switch (field) {
+			case Field::Axis:			vector[axis] = value; break;
+			case Field::Mass:			record->mass = value; break;
+			case Field::Radius:			record->capsuleRadius = value; break;
+			case Field::Height:			record->capsuleHeight = value; break;
+			case Field::RenderScale:	record->renderScale = value; break;
+			case Field::ComponentParam:	AddParam(ParamNumber, value); break;
+			default: break;
+			}
+			return true;
+		}
+
+		void SetFlag(uint8_t flag, bool set) {
+			if (set)
+				record->flags |= flag;
+			else
+				record->flags &= ~flag;
+		}
+
+		bool BeginVector(float* values, int size) {
+			vector = values;
+			vectorSize = size;
+			scopes.push_back(Scope::Vector);
+			return true;
+		}
+
+		//prefabs are read like objects but kept aside rather than added to the level
+		void BeginObject(bool isPrefab) {
+			definingPrefab = isPrefab;
+			if (isPrefab) {
+				prefabs.emplace_back();
+				record = &prefabs.back().record;
+			}
+			else
+				record = &level.AddObject();
+
+			record->name = record->tag = record->parent = NO_STRING;
+			record->position[0] = record->position[1] = record->position[2] = 0.0f;
+			record->orientation[0] = record->orientation[1] = record->orientation[2] = 0.0f;
+			record->orientation[3] = 1.0f;
+			record->scale[0] = record->scale[1] = record->scale[2] = 1.0f;
+			record->mesh = record->material = record->texture = record->animation = NO_STRING;
+			record->renderScale = 1.0f;
+			record->mass = record->capsuleRadius = record->capsuleHeight = 0.0f;
+			record->collider = ColliderNone;
+			record->flags = 0;
+			record->componentCount = 0;
+			record->firstComponent = level.GetComponentCount();
+
+			hasPhysics = hasRender = kinematic = false;
+			prefab = NO_STRING;
+			overrides = 0;
+		}
+
+		//keys can come in any order, so prefabs, physics and render are only settled once the
+		//object is read
+		void EndObject() {
+			if (prefab != NO_STRING)
+				ApplyPrefab();
+
+			if (definingPrefab) {
+				EndPrefab();
+				return;
+			}
+
+			if (record->name == NO_STRING)
+				record->name = level.AddString("unnamed");
+
+			if (hasPhysics && record->mass != -1.0f) {
+				record->flags |= HasPhysics;
+				if (std::abs(record->mass) < 0.001f || kinematic)
+					record->mass = 0.0f;
+				if (record->collider != ColliderCapsule)
+					record->capsuleRadius = record->capsuleHeight = 0.0f;
+			}
+			else {
+				record->collider = ColliderNone;
+				record->mass = record->capsuleRadius = record->capsuleHeight = 0.0f;
+				record->flags &= ~IsTrigger;
+			}
+
+			if (hasRender && record->mesh != NO_STRING && *level.GetString(record->mesh) != '\0') {
+				record->flags |= HasRender;
+				if (record->texture == NO_STRING)
+					record->texture = level.AddString("checkerboard.png");
+			}
+			else {
+				record->mesh = record->material = record->texture = record->animation = NO_STRING;
+				record->renderScale = 1.0f;
+			}
+
+			record = nullptr;
+		}
+
+		void EndPrefab() {
+			Prefab& defined = prefabs.back();
+			defined.hasPhysics = hasPhysics;
+			defined.hasRender = hasRender;
+			defined.kinematic = kinematic;
+
+			if (record->name == NO_STRING) {
+				std::cout << "Level reader: ignoring a prefab with no name" << std::endl;
+				prefabs.pop_back();
+			}
+			else
+				prefabsByName[record->name] = (uint32_t)prefabs.size() - 1;
+
+			record = nullptr;
+			definingPrefab = false;
+		}
+
+		//fills in everything the object didn't set itself. Strings are shared through the string
+		//table and components through the prefab's component records, so nothing is copied
+		void ApplyPrefab() {
+			auto found = prefabsByName.find(prefab);
+			if (found == prefabsByName.end()) {
+				std::cout << "Level reader: no prefab called " << level.GetString(prefab) << std::endl;
+				return;
+			}
+			const Prefab& source = prefabs[found->second];
+			const ObjectRecord& from = source.record;
+
+			if (!(overrides & OverrideName))
+				record->name = from.name;
+			if (!(overrides & OverrideTag))
+				record->tag = from.tag;
+			if (!(overrides & OverrideParent))
+				record->parent = from.parent;
+			if (!(overrides & OverrideStatic))
+				SetFlag(IsStatic, (from.flags & IsStatic) != 0);
+
+			if (!(overrides & OverridePosition))
+				std::copy(from.position, from.position + 3, record->position);
+			if (!(overrides & OverrideOrientation))
+				std::copy(from.orientation, from.orientation + 4, record->orientation);
+			if (!(overrides & OverrideScale))
+				std::copy(from.scale, from.scale + 3, record->scale);
+
+			if (!(overrides & OverridePhysics)) {
+				hasPhysics = source.hasPhysics;
+				kinematic = source.kinematic;
+				record->mass = from.mass;
+			}
+			if (!(overrides & OverrideCollider)) {
+				record->collider = from.collider;
+				record->capsuleRadius = from.capsuleRadius;
+				record->capsuleHeight = from.capsuleHeight;
+				SetFlag(IsTrigger, (from.flags & IsTrigger) != 0);
+			}
+			if (!(overrides & OverrideRender)) {
+				hasRender = source.hasRender;
+				record->mesh = from.mesh;
+				record->material = from.material;
+				record->texture = from.texture;
+				record->animation = from.animation;
+				record->renderScale = from.renderScale;
+			}
+			if (!(overrides & OverrideComponents)) {
+				record->firstComponent = from.firstComponent;
+				record->componentCount = from.componentCount;
+			}
+		}
+
+		void BeginComponent() {
+			component = &level.AddComponent();
+			component->name = NO_STRING;
+			component->nameHash = 0;
+			component->firstParam = level.GetParamCount();
+			component->paramCount = 0;
+		}
+
+		void EndComponent() {
+			if (component->name == NO_STRING)
+				level.RemoveLastComponent();
+			else
+				record->componentCount++;
+			component = nullptr;
+		}
+
+		ParamRecord& AddParam(ParamType type, float value) {
+			ParamRecord& param = level.AddParam();
+			param.key = paramKey;
+			param.keyHash = paramHash;
+			param.type = type;
+			param.values[0] = value;
+			param.values[1] = param.values[2] = 0.0f;
+			param.string = NO_STRING;
+			component->paramCount++;
+			return param;
+		}
+
+		void SkipParam() {
+			std::cout << "Level reader: skipping parameter " << level.GetString(paramKey) << std::endl;
+		}
+
+		LevelData& level;
+
+		std::vector<Scope> scopes;
+		Field field;
+
+		ObjectRecord*		record;
+		ComponentRecord*	component;
+		uint32_t			paramKey;
+		uint32_t			paramHash;
+
+		float*	vector;
+		int		vectorSize;
+		int		axis;
+
+		bool hasPhysics;
+		bool hasRender;
+		bool kinematic;
+
+		//prefabs by the string offset of their name, which is unique as the table has no duplicates
+		std::vector<Prefab>						prefabs;
+		std::unordered_map<uint32_t, uint32_t>	prefabsByName;
+		uint32_t	prefab;
+		uint32_t	overrides;
+		bool		definingPrefab;
+		bool		foundObjects;
+	};
+}
+
+bool JSONLevelReader::Read(const char* begin, const char* end, LevelData& level) {
+	LevelHandler handler(level);
+	return json::sax_parse(begin, end, &handler) && handler.FoundObjects();
+}
+
+bool JSONLevelReader::ReadFile(const std::string& fileName, LevelData& level) {
+	MappedFile file(Assets::LEVELSDIR + fileName);
+	if (!file.IsOpen()) {
+		std::cout << "Level reader: couldn't open " << fileName << std::endl;
+		return false;
+	}
+	return Read(file.GetData(), file.GetData() + file.GetSize(), level);
+}
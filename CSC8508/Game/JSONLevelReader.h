@@ -0,0 +1,22 @@
+#pragma once
+#include <string>
+
+namespace NCL {
+	namespace CSC8508 {
+
+		class LevelData;
+
+		//streams level json straight into level records without building a json document.
+		//A level is either an array of objects or an object with "prefabs" and then "objects".
+		//An object naming a "prefab" takes every block it doesn't set itself from that prefab;
+		//name, tag, parent, isStatic, physics, collider, render and components are replaced whole,
+		//the transform's position, orientation and scale one at a time
+		namespace JSONLevelReader {
+			//false if the text isn't a level
+			bool Read(const char* begin, const char* end, LevelData& level);
+
+			//maps a file from the levels folder and reads it in place
+			bool ReadFile(const std::string& fileName, LevelData& level);
+		}
+	}
+}
@@ -0,0 +1,186 @@
+#include "LevelBaker.h"
+#include "LevelData.h"
+#include "JSONLevelReader.h"
+
+#include "../../Common/Assets.h"
+#include "../../Common/GameTimer.h"
+#include "../../Plugins/json/json.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+
+using namespace NCL;
+using namespace CSC8508;
+
+//keeps keys in file order, the reader needs "prefabs" ahead of "objects"
+using json = nlohmann::ordered_json;
+
+namespace {
+	const char* TRANSFORM_PARTS[] = { "position", "orientation", "scale" };
+
+	//everything an instance can't set without overriding a whole block
+	json GetShared(const json& object) {
+		json shared = object;
+		shared.erase("name");
+		shared.erase("parent");
+		shared.erase("transform");
+		return shared;
+	}
+
+	//"Cube (50)" -> "Cube"
+	std::string GetBaseName(const std::string& name) {
+		size_t bracket = name.rfind(" (");
+		if (bracket == std::string::npos || name.back() != ')')
+			return name;
+		return name.substr(0, bracket);
+	}
+
+	std::string MakeUniqueName(const std::string& name, std::set<std::string>& used) {
+		std::string unique = name;
+		for (int i = 2; !used.insert(unique).second; ++i)
+			unique = name + " " + std::to_string(i);
+		return unique;
+	}
+
+	const json* FindTransformPart(const json& object, const char* part) {
+		auto transform = object.find("transform");
+		if (transform == object.end())
+			return nullptr;
+		auto value = transform->find(part);
+		return value == transform->end() ? nullptr : &*value;
+	}
+}
+
+bool LevelBaker::BakeFile(const std::string& fileName) {
+	GameTimer timer;
+
+	LevelData level;
+	if (!JSONLevelReader::ReadFile(fileName, level)) {
+		std::cout << "Level baker: " << fileName << " isn't a level" << std::endl;
+		return false;
+	}
+
+	std::string bakedName = GetBakedName(fileName);
+	bool written = level.WriteBinary(Assets::LEVELSDIR + bakedName);
+	timer.Tick();
+
+	if (written) {
+		std::cout << "Level baker: " << fileName << " -> " << bakedName << ", " << level.GetObjectCount() << " objects, "
+			<< level.GetComponentCount() << " components in " << timer.GetTimeDeltaMSec() << "ms" << std::endl;
+	}
+	return written;
+}
+
+bool LevelBaker::MakePrefabs(const std::string& fileName) {
+	std::string path = Assets::LEVELSDIR + fileName;
+	json objects;
+	{
+		std::ifstream input(path);
+		objects = json::parse(input, nullptr, false);
+	}
+
+	if (!objects.is_array()) {
+		std::cout << "Level baker: " << fileName << " isn't a level without prefabs" << std::endl;
+		return false;
+	}
+
+	//objects sharing everything but name, parent and transform, in the order they first appear
+	std::map<std::string, size_t> groupsByShared;
+	std::vector<std::vector<size_t>> groups;
+	std::vector<size_t> objectGroups;
+	for (size_t i = 0; i < objects.size(); ++i) {
+		auto group = groupsByShared.emplace(GetShared(objects[i]).dump(), groups.size());
+		if (group.second)
+			groups.emplace_back();
+		groups[group.first->second].push_back(i);
+		objectGroups.push_back(group.first->second);
+	}
+
+	json prefabs = json::array();
+	std::vector<std::string> prefabNames(groups.size());
+	std::vector<std::set<std::string>> commonParts(groups.size());
+	std::set<std::string> usedNames;
+	for (size_t g = 0; g < groups.size(); ++g) {
+		const std::vector<size_t>& members = groups[g];
+		if (members.size() < 2)
+			continue;
+
+		const json& first = objects[members[0]];
+		prefabNames[g] = MakeUniqueName(GetBaseName(first.value("name", "Prefab")), usedNames);
+
+		json prefab;
+		prefab["name"] = prefabNames[g];
+		json shared = GetShared(first);
+		for (auto& item : shared.items())
+			prefab[item.key()] = item.value();
+
+		//transform parts every member agrees on move into the prefab
+		json transform = json::object();
+		for (const char* part : TRANSFORM_PARTS) {
+			const json* value = FindTransformPart(first, part);
+			if (!value)
+				continue;
+
+			bool common = true;
+			for (size_t member : members) {
+				const json* memberValue = FindTransformPart(objects[member], part);
+				common = common && memberValue && *memberValue == *value;
+			}
+			if (common) {
+				transform[part] = *value;
+				commonParts[g].insert(part);
+			}
+		}
+		if (!transform.empty())
+			prefab["transform"] = transform;
+
+		prefabs.push_back(prefab);
+	}
+
+	json instances = json::array();
+	for (size_t i = 0; i < objects.size(); ++i) {
+		size_t g = objectGroups[i];
+		if (prefabNames[g].empty()) {
+			instances.push_back(objects[i]);
+			continue;
+		}
+
+		const json& object = objects[i];
+		json instance;
+		if (object.contains("name"))
+			instance["name"] = object["name"];
+		instance["prefab"] = prefabNames[g];
+		if (object.contains("parent"))
+			instance["parent"] = object["parent"];
+
+		json transform = json::object();
+		for (const char* part : TRANSFORM_PARTS) {
+			const json* value = FindTransformPart(object, part);
+			if (value && !commonParts[g].count(part))
+				transform[part] = *value;
+		}
+		if (!transform.empty())
+			instance["transform"] = transform;
+
+		instances.push_back(instance);
+	}
+
+	json level;
+	level["prefabs"] = prefabs;
+	level["objects"] = instances;
+
+	std::ofstream output(path);
+	output << level.dump(4);
+	if (!output)
+		return false;
+
+	std::cout << "Level baker: " << fileName << ", " << objects.size() << " objects using " << prefabs.size() << " prefabs" << std::endl;
+	return true;
+}
+
+std::string LevelBaker::GetBakedName(const std::string& fileName) {
+	size_t extension = fileName.find_last_of('.');
+	return (extension == std::string::npos ? fileName : fileName.substr(0, extension)) + ".lvl";
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include <string>
+
+namespace NCL {
+	namespace CSC8508 {
+
+		//turns level json, which stays the authoring format, into baked level files
+		namespace LevelBaker {
+			//reads a level from the levels folder and writes its baked file next to it
+			bool BakeFile(const std::string& fileName);
+
+			//rewrites a level in the levels folder so objects that only differ by name, parent and
+			//transform become instances of one prefab
+			bool MakePrefabs(const std::string& fileName);
+
+			//"Level1.json" -> "Level1.lvl"
+			std::string GetBakedName(const std::string& fileName);
+		}
+	}
+}
@@ -0,0 +1,190 @@
+#include "LevelData.h"
+
+#include "../../Common/MappedFile.h"
+
+#include <fstream>
+#include <iostream>
+
+using namespace NCL;
+using namespace CSC8508;
+using namespace LevelFormat;
+
+namespace {
+	uint32_t Align4(uint32_t offset) {
+		return (offset + 3) & ~3u;
+	}
+
+	//checks a record array lies inside the file
+	bool SectionFits(uint32_t offset, uint32_t count, size_t recordSize, size_t fileSize) {
+		return offset % 4 == 0 && offset <= fileSize && count <= (fileSize - offset) / recordSize;
+	}
+
+	//checks a string offset points into the table, which is known to end with a nul
+	bool StringFits(uint32_t offset, uint32_t tableSize, bool optional) {
+		return offset < tableSize || (optional && offset == NO_STRING);
+	}
+
+	bool RangeFits(uint32_t first, uint32_t count, uint32_t total) {
+		return first <= total && count <= total - first;
+	}
+
+	//the factory reads records without checking them, so every offset and index range is checked here
+	bool RecordsFit(const Header& header, const ObjectRecord* objects, const ComponentRecord* components, const ParamRecord* params) {
+		uint32_t strings = header.stringTableSize;
+
+		for (uint32_t i = 0; i < header.objectCount; ++i) {
+			const ObjectRecord& o = objects[i];
+			if (!StringFits(o.name, strings, false) || !StringFits(o.tag, strings, true) || !StringFits(o.parent, strings, true)
+				|| !StringFits(o.mesh, strings, true) || !StringFits(o.material, strings, true)
+				|| !StringFits(o.texture, strings, true) || !StringFits(o.animation, strings, true)
+				|| !RangeFits(o.firstComponent, o.componentCount, header.componentCount))
+				return false;
+		}
+
+		for (uint32_t i = 0; i < header.componentCount; ++i) {
+			const ComponentRecord& c = components[i];
+			if (!StringFits(c.name, strings, false) || !RangeFits(c.firstParam, c.paramCount, header.paramCount))
+				return false;
+		}
+
+		for (uint32_t i = 0; i < header.paramCount; ++i) {
+			const ParamRecord& p = params[i];
+			if (!StringFits(p.key, strings, true) || !StringFits(p.string, strings, true))
+				return false;
+		}
+		return true;
+	}
+}
+
+LevelData::LevelData() {
+	objects			= nullptr;
+	components		= nullptr;
+	params			= nullptr;
+	strings			= nullptr;
+	objectCount		= 0;
+	componentCount	= 0;
+	paramCount		= 0;
+	stringTableSize	= 0;
+	file			= nullptr;
+}
+
+LevelData::~LevelData() {
+	delete file;
+}
+
+LevelData* LevelData::LoadBinary(const std::string& fileName) {
+	MappedFile* mapped = new MappedFile(fileName);
+	if (!mapped->IsOpen() || mapped->GetSize() < sizeof(Header)) {
+		delete mapped;
+		return nullptr;
+	}
+
+	const char* base = mapped->GetData();
+	size_t size = mapped->GetSize();
+	const Header* header = (const Header*)base;
+
+	bool valid = header->magic == MAGIC && header->version == VERSION
+		&& SectionFits(header->objectOffset, header->objectCount, sizeof(ObjectRecord), size)
+		&& SectionFits(header->componentOffset, header->componentCount, sizeof(ComponentRecord), size)
+		&& SectionFits(header->paramOffset, header->paramCount, sizeof(ParamRecord), size)
+		&& header->stringTableOffset <= size && header->stringTableSize <= size - header->stringTableOffset
+		&& (header->stringTableSize == 0 || base[header->stringTableOffset + header->stringTableSize - 1] == '\0')
+		&& RecordsFit(*header, (const ObjectRecord*)(base + header->objectOffset),
+			(const ComponentRecord*)(base + header->componentOffset), (const ParamRecord*)(base + header->paramOffset));
+
+	if (!valid) {
+		std::cout << "Level file " << fileName << " is out of date or damaged, ignoring it" << std::endl;
+		delete mapped;
+		return nullptr;
+	}
+
+	LevelData* level = new LevelData();
+	level->file				= mapped;
+	level->objects			= (const ObjectRecord*)(base + header->objectOffset);
+	level->components		= (const ComponentRecord*)(base + header->componentOffset);
+	level->params			= (const ParamRecord*)(base + header->paramOffset);
+	level->strings			= base + header->stringTableOffset;
+	level->objectCount		= header->objectCount;
+	level->componentCount	= header->componentCount;
+	level->paramCount		= header->paramCount;
+	level->stringTableSize	= header->stringTableSize;
+	return level;
+}
+
+bool LevelData::WriteBinary(const std::string& fileName) const {
+	Header header;
+	header.magic			= MAGIC;
+	header.version			= VERSION;
+	header.objectCount		= objectCount;
+	header.componentCount	= componentCount;
+	header.paramCount		= paramCount;
+	header.stringTableSize	= stringTableSize;
+
+	header.objectOffset			= Align4(sizeof(Header));
+	header.componentOffset		= Align4(header.objectOffset + objectCount * sizeof(ObjectRecord));
+	header.paramOffset			= Align4(header.componentOffset + componentCount * sizeof(ComponentRecord));
+	header.stringTableOffset	= Align4(header.paramOffset + paramCount * sizeof(ParamRecord));
+
+	std::ofstream output(fileName, std::ios::binary);
+	if (!output) {
+		std::cout << "Couldn't open " << fileName << " for writing" << std::endl;
+		return false;
+	}
+
+	//every record size is a multiple of 4, so the sections follow each other with no padding
+	output.write((const char*)&header, sizeof(Header));
+	output.write((const char*)objects, objectCount * sizeof(ObjectRecord));
+	output.write((const char*)components, componentCount * sizeof(ComponentRecord));
+	output.write((const char*)params, paramCount * sizeof(ParamRecord));
+	output.write(strings, stringTableSize);
+	return (bool)output;
+}
+
+uint32_t LevelData::AddString(const std::string& text) {
+	auto found = stringOffsets.find(text);
+	if (found != stringOffsets.end())
+		return found->second;
+
+	uint32_t offset = (uint32_t)ownedStrings.size();
+	ownedStrings.insert(ownedStrings.end(), text.begin(), text.end());
+	ownedStrings.push_back('\0');
+	stringOffsets.emplace(text, offset);
+
+	RefreshOwnedPointers();
+	return offset;
+}
+
+ObjectRecord& LevelData::AddObject() {
+	ownedObjects.push_back(ObjectRecord());
+	RefreshOwnedPointers();
+	return ownedObjects.back();
+}
+
+ComponentRecord& LevelData::AddComponent() {
+	ownedComponents.push_back(ComponentRecord());
+	RefreshOwnedPointers();
+	return ownedComponents.back();
+}
+
+ParamRecord& LevelData::AddParam() {
+	ownedParams.push_back(ParamRecord());
+	RefreshOwnedPointers();
+	return ownedParams.back();
+}
+
+void LevelData::RemoveLastComponent() {
+	ownedParams.resize(ownedComponents.back().firstParam);
+	ownedComponents.pop_back();
+	RefreshOwnedPointers();
+}
+
+void LevelData::RefreshOwnedPointers() {
+	objects			= ownedObjects.data();
+	components		= ownedComponents.data();
+	params			= ownedParams.data();
+	strings			= ownedStrings.data();
+	objectCount		= (uint32_t)ownedObjects.size();
+	componentCount	= (uint32_t)ownedComponents.size();
+	paramCount		= (uint32_t)ownedParams.size();
+	stringTableSize	= (uint32_t)ownedStrings.size();
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include "LevelFormat.h"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace NCL {
+	class MappedFile;
+
+	namespace CSC8508 {
+
+		//the records of one level, either read in place from a mapped baked file or built in memory
+		//while reading json. Either way the objects are reached through the same accessors
+		class LevelData {
+		public:
+			LevelData();
+			~LevelData();
+
+			//null if the file is missing, isn't a level, was baked by another version or is damaged
+			static LevelData* LoadBinary(const std::string& fileName);
+			bool WriteBinary(const std::string& fileName) const;
+
+			uint32_t GetObjectCount() const { return objectCount; }
+			const LevelFormat::ObjectRecord&	GetObject(uint32_t i)		const { return objects[i]; }
+			const LevelFormat::ComponentRecord&	GetComponent(uint32_t i)	const { return components[i]; }
+			const LevelFormat::ParamRecord&		GetParam(uint32_t i)		const { return params[i]; }
+
+			//null for NO_STRING
+			const char* GetString(uint32_t offset) const {
+				return offset == LevelFormat::NO_STRING ? nullptr : strings + offset;
+			}
+
+			//building, only for levels that don't come from a file. References are only valid
+			//until the next record of the same kind is added
+			uint32_t AddString(const std::string& text);
+			LevelFormat::ObjectRecord&		AddObject();
+			LevelFormat::ComponentRecord&	AddComponent();
+			LevelFormat::ParamRecord&		AddParam();
+
+			//drops the last component added along with its parameters
+			void RemoveLastComponent();
+
+			uint32_t GetComponentCount()	const { return componentCount; }
+			uint32_t GetParamCount()		const { return paramCount; }
+
+		protected:
+			void RefreshOwnedPointers();
+
+			const LevelFormat::ObjectRecord*	objects;
+			const LevelFormat::ComponentRecord*	components;
+			const LevelFormat::ParamRecord*		params;
+			const char*							strings;
+			uint32_t objectCount;
+			uint32_t componentCount;
+			uint32_t paramCount;
+			uint32_t stringTableSize;
+
+			MappedFile* file;
+
+			std::vector<LevelFormat::ObjectRecord>		ownedObjects;
+			std::vector<LevelFormat::ComponentRecord>	ownedComponents;
+			std::vector<LevelFormat::ParamRecord>		ownedParams;
+			std::vector<char>							ownedStrings;
+			std::unordered_map<std::string, uint32_t>	stringOffsets;
+		};
+	}
+}
@@ -0,0 +1,308 @@
+#include "LevelFactory.h"
+#include "LevelData.h"
+#include "LevelBaker.h"
+#include "JSONLevelFactory.h"
+#include "ComponentFactory.h"
+#include "Game.h"
+
+#include "../Engine/GameObject.h"
+#include "../Engine/JobSystem.h"
+#include "../Engine/Profiler.h"
+#include "../Engine/Physics/PhysicsEngine/BulletWorld.h"
+#include "../../Common/Assets.h"
+#include "../../Common/GameTimer.h"
+#include "../../Common/ResourceManager.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <unordered_map>
+
+using namespace NCL;
+using namespace CSC8508;
+using namespace LevelFormat;
+
+namespace {
+	//objects are split up into ranges of at least this many for decoding
+	const int MIN_OBJECTS_PER_JOB = 16;
+
+	//everything about an object that can be worked out away from the main thread
+	struct DecodedObject {
+		Vector3				position;
+		Quaternion			orientation;
+		Vector3				scale;
+		physics::SharedShape*	shape;
+	};
+
+	//API objects for each distinct resource name in the level, keyed by string offset
+	struct LevelResources {
+		std::unordered_map<uint32_t, MeshGeometry*>		meshes;
+		std::unordered_map<uint32_t, MeshMaterial*>		materials;
+		std::unordered_map<uint32_t, TextureBase*>		textures;
+		std::unordered_map<uint32_t, MeshAnimation*>	animations;
+		ShaderBase* shader;
+	};
+
+	//objects can name a parent anywhere in the level, so they are linked once everything exists.
+	//Positions in the file stay world positions
+	class ParentLinks {
+	public:
+		void Add(GameObject* object, const char* parentName) {
+			namedObjects.emplace(object->GetName(), object);
+			if (parentName)
+				links.push_back(std::make_pair(object, parentName));
+		}
+
+		void Link(const std::string& levelName) {
+			for (auto& link : links) {
+				auto parent = namedObjects.find(link.second);
+				if (parent == namedObjects.end()) {
+					std::cout << "Level " << levelName << ": no parent called " << link.second << " for " << link.first->GetName() << std::endl;
+					continue;
+				}
+				link.first->GetTransform().SetParent(&parent->second->GetTransform());
+			}
+		}
+
+	protected:
+		std::map<std::string, GameObject*> namedObjects;
+		std::vector<std::pair<GameObject*, const char*>> links;
+	};
+
+	//objects with the same collider and size share one bullet shape, which prefab instances
+	//usually do
+	struct ShapeKey {
+		uint8_t	collider;
+		float	size[3];
+
+		bool operator<(const ShapeKey& other) const {
+			if (collider != other.collider)
+				return collider < other.collider;
+			return std::lexicographical_compare(size, size + 3, other.size, other.size + 3);
+		}
+	};
+
+	Vector3 ToVector3(const float* values) {
+		return Vector3(values[0], values[1], values[2]);
+	}
+
+	void CollectResources(const LevelData& level, LevelResources& resources) {
+		for (uint32_t i = 0; i < level.GetObjectCount(); ++i) {
+			const ObjectRecord& record = level.GetObject(i);
+			if (!(record.flags & HasRender))
+				continue;
+
+			resources.meshes.emplace(record.mesh, nullptr);
+			resources.textures.emplace(record.texture, nullptr);
+			if (record.material != NO_STRING)
+				resources.materials.emplace(record.material, nullptr);
+			if (record.animation != NO_STRING)
+				resources.animations.emplace(record.animation, nullptr);
+		}
+	}
+
+	//reads and decodes every resource file on the workers, the Load calls later only create API objects
+	void PreloadResources(const LevelData& level, const LevelResources& resources, ResourceManager* resourceManager, JobCounter& counter) {
+		for (auto& mesh : resources.meshes) {
+			const char* name = level.GetString(mesh.first);
+			JobSystem::Run([resourceManager, name]() { resourceManager->PreloadMesh(name); }, &counter);
+		}
+		for (auto& material : resources.materials) {
+			const char* name = level.GetString(material.first);
+			JobSystem::Run([resourceManager, name]() { resourceManager->PreloadMaterial(name); }, &counter);
+		}
+		for (auto& texture : resources.textures) {
+			const char* name = level.GetString(texture.first);
+			JobSystem::Run([resourceManager, name]() { resourceManager->PreloadTexture(name); }, &counter);
+		}
+		for (auto& animation : resources.animations) {
+			const char* name = level.GetString(animation.first);
+			JobSystem::Run([resourceManager, name]() { resourceManager->PreloadAnimation(name); }, &counter);
+		}
+	}
+
+	void LoadResources(const LevelData& level, LevelResources& resources, ResourceManager* resourceManager) {
+		for (auto& mesh : resources.meshes)
+			mesh.second = resourceManager->LoadMesh(level.GetString(mesh.first));
+		for (auto& material : resources.materials)
+			material.second = resourceManager->LoadMaterial(level.GetString(material.first));
+		for (auto& texture : resources.textures)
+			texture.second = resourceManager->LoadTexture(level.GetString(texture.first));
+		for (auto& animation : resources.animations)
+			animation.second = resourceManager->LoadAnimation(level.GetString(animation.first));
+
+		resources.shader = resourceManager->LoadShader("GameTechVert.glsl", "GameTechFrag.glsl");
+	}
+
+	//the render scale isn't part of the collision shape
+	ShapeKey GetShapeKey(const ObjectRecord& record) {
+		ShapeKey key = { record.collider, { 0.0f, 0.0f, 0.0f } };
+		switch (record.collider) {
+		case ColliderBox:
+			std::copy(record.scale, record.scale + 3, key.size);
+			break;
+		case ColliderSphere:
+			key.size[0] = record.scale[0];
+			break;
+		case ColliderCapsule:
+			key.size[0] = record.capsuleRadius;
+			key.size[1] = record.scale[1] * record.capsuleHeight;
+			break;
+		}
+		return key;
+	}
+
+	btCollisionShape* BuildShape(const ShapeKey& key) {
+		switch (key.collider) {
+		case ColliderBox:		return ArenaNew<btBoxShape>(btVector3(key.size[0], key.size[1], key.size[2]) / 2.0f);
+		case ColliderSphere:	return ArenaNew<btSphereShape>(key.size[0] / 2.0f);
+		case ColliderCapsule:	return ArenaNew<btCapsuleShape>(key.size[0], key.size[1] / 2.0f);
+		}
+		return nullptr;
+	}
+
+	//shapes are built up front so the decode jobs only read the map
+	void CollectShapes(const LevelData& level, std::map<ShapeKey, physics::SharedShape*>& shapes) {
+		for (uint32_t i = 0; i < level.GetObjectCount(); ++i) {
+			const ObjectRecord& record = level.GetObject(i);
+			if (!(record.flags & HasPhysics))
+				continue;
+
+			ShapeKey key = GetShapeKey(record);
+			if (shapes.count(key))
+				continue;
+
+			btCollisionShape* shape = BuildShape(key);
+			shapes.emplace(key, shape ? new physics::SharedShape(shape) : nullptr);
+		}
+	}
+
+	void DecodeObject(const ObjectRecord& record, const std::map<ShapeKey, physics::SharedShape*>& shapes, DecodedObject& decoded) {
+		decoded.position = ToVector3(record.position);
+		decoded.orientation = Quaternion(record.orientation[0], record.orientation[1], record.orientation[2], record.orientation[3]);
+		decoded.scale = ToVector3(record.scale);
+		decoded.shape = (record.flags & HasPhysics) ? shapes.at(GetShapeKey(record)) : nullptr;
+	}
+
+	//everything that touches the game and physics worlds
+	GameObject* CommitObject(const LevelData& level, const ObjectRecord& record, DecodedObject& decoded, const LevelResources& resources, Game* game) {
+		GameObject* go = new GameObject(level.GetString(record.name));
+		Transform& transform = go->GetTransform();
+
+		transform.SetPosition(decoded.position);
+		transform.SetOrientation(decoded.orientation);
+		transform.SetScale(decoded.scale);
+
+		if (record.flags & HasPhysics) {
+			PhysicsObject* po = new PhysicsObject(&transform, go->GetBoundingVolume());
+			if (decoded.shape)
+				po->body->setShape(decoded.shape);
+			po->body->createBody(record.mass, 0.4f, 0.4f, game->GetPhysics());
+			po->body->setUserPointer(go);
+
+			if (record.flags & IsTrigger)
+				po->body->makeTrigger();
+
+			go->SetPhysicsObject(po);
+		}
+
+		if (record.flags & HasRender) {
+			MeshMaterial* meshMat = record.material != NO_STRING ? resources.materials.at(record.material) : nullptr;
+			MeshAnimation* meshAnim = record.animation != NO_STRING ? resources.animations.at(record.animation) : nullptr;
+
+			transform.SetScale(decoded.scale * record.renderScale);
+			go->SetRenderObject(new RenderObject(&transform, resources.meshes.at(record.mesh), meshMat,
+				resources.textures.at(record.texture), meshAnim, resources.shader));
+		}
+
+		if (record.tag != NO_STRING)
+			go->AddTag(level.GetString(record.tag));
+
+		go->SetIsStatic((record.flags & IsStatic) != 0);
+
+		for (uint32_t i = 0; i < record.componentCount; ++i) {
+			const ComponentRecord& component = level.GetComponent(record.firstComponent + i);
+			if (!ComponentFactory::AddComponent(component.nameHash, go, game, ComponentParams(level, component)))
+				std::cout << "Level factory: no component called " << level.GetString(component.name) << " for " << go->GetName() << std::endl;
+		}
+
+		game->AddGameObject(go);
+		return go;
+	}
+
+	//a baked file older than its json would load a stale level, so it's only used when it is newer
+	bool IsBakedUpToDate(const std::string& jsonPath, const std::string& bakedPath) {
+		std::error_code error;
+		auto bakedTime = std::filesystem::last_write_time(bakedPath, error);
+		if (error)
+			return false;
+
+		auto jsonTime = std::filesystem::last_write_time(jsonPath, error);
+		return error || bakedTime >= jsonTime;
+	}
+}
+
+void LevelFactory::LoadLevel(const std::string& fileName, Game* game) {
+	std::string jsonPath = Assets::LEVELSDIR + fileName;
+	std::string bakedPath = Assets::LEVELSDIR + LevelBaker::GetBakedName(fileName);
+
+	if (IsBakedUpToDate(jsonPath, bakedPath)) {
+		GameTimer timer;
+		LevelData* level = LevelData::LoadBinary(bakedPath);
+		timer.Tick();
+
+		if (level) {
+			std::cout << "Level " << fileName << ": baked file mapped in " << timer.GetTimeDeltaMSec() << "ms" << std::endl;
+			Instantiate(*level, game, fileName);
+			delete level;
+			return;
+		}
+	}
+
+	JSONLevelFactory::ReadLevelFromJson(fileName, game);
+}
+
+//objects are decoded on every thread while resource files are read, then created on the main
+//thread, which is the only one allowed to touch the worlds and the graphics context
+void LevelFactory::Instantiate(const LevelData& level, Game* game, const std::string& levelName) {
+	GameTimer timer;
+	ResourceManager* resourceManager = game->GetResourceManager();
+	uint32_t objectCount = level.GetObjectCount();
+
+	LevelResources resources;
+	std::map<ShapeKey, physics::SharedShape*> shapes;
+	std::vector<DecodedObject> decoded(objectCount);
+	{
+		PROFILE_SCOPE("LevelFactory::Decode");
+		CollectResources(level, resources);
+		CollectShapes(level, shapes);
+
+		JobCounter preloading;
+		PreloadResources(level, resources, resourceManager, preloading);
+
+		JobSystem::ParallelFor((int)objectCount, MIN_OBJECTS_PER_JOB, [&](int begin, int end) {
+			for (int i = begin; i < end; ++i)
+				DecodeObject(level.GetObject(i), shapes, decoded[i]);
+		});
+		JobSystem::Wait(preloading);
+	}
+	timer.Tick();
+	float decodeTime = timer.GetTimeDeltaMSec();
+
+	{
+		PROFILE_SCOPE("LevelFactory::Commit");
+		LoadResources(level, resources, resourceManager);
+
+		ParentLinks parentLinks;
+		for (uint32_t i = 0; i < objectCount; ++i) {
+			const ObjectRecord& record = level.GetObject(i);
+			parentLinks.Add(CommitObject(level, record, decoded[i], resources, game), level.GetString(record.parent));
+		}
+		parentLinks.Link(levelName);
+	}
+	timer.Tick();
+
+	std::cout << "Level " << levelName << ": " << objectCount << " objects sharing " << shapes.size() << " shapes decoded in "
+		<< decodeTime << "ms on " << JobSystem::GetThreadCount() << " threads, committed in " << timer.GetTimeDeltaMSec() << "ms" << std::endl;
+}
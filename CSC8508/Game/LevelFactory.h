@@ -0,0 +1,19 @@
+#pragma once
+#include <string>
+
+namespace NCL {
+	namespace CSC8508 {
+
+		class Game;
+		class LevelData;
+
+		namespace LevelFactory {
+			//loads the baked copy of a level when there is one at least as new as its json,
+			//otherwise reads the json
+			void LoadLevel(const std::string& fileName, Game* game);
+
+			//creates every object in the level, then links parents by name
+			void Instantiate(const LevelData& level, Game* game, const std::string& levelName);
+		}
+	}
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include <cstdint>
+
+namespace NCL {
+	namespace CSC8508 {
+
+		//layout of baked level files. A file is a header followed by the object, component and
+		//parameter record arrays and then the string table, every section 4 byte aligned. Records
+		//are plain data read in place from the mapped file, strings are offsets into the table.
+		//Bump VERSION whenever a record changes so stale files are ignored rather than misread
+		namespace LevelFormat {
+
+			const uint32_t MAGIC		= 0x4C564C4E; //"NLVL"
+			const uint32_t VERSION		= 2;
+			const uint32_t NO_STRING	= 0xFFFFFFFF;
+
+			//FNV-1a, stored next to component names and parameter keys so they can be matched
+			//without comparing strings
+			constexpr uint32_t HashName(const char* name) {
+				uint32_t hash = 2166136261u;
+				while (*name)
+					hash = (hash ^ (uint8_t)*name++) * 16777619u;
+				return hash;
+			}
+
+			enum ColliderType : uint8_t {
+				ColliderNone,
+				ColliderBox,
+				ColliderSphere,
+				ColliderCapsule
+			};
+
+			enum ObjectFlags : uint8_t {
+				HasPhysics	= 1 << 0,
+				HasRender	= 1 << 1,
+				IsStatic	= 1 << 2,
+				IsTrigger	= 1 << 3
+			};
+
+			enum ParamType : uint32_t {
+				ParamNumber,
+				ParamBool,
+				ParamString,
+				ParamVector3
+			};
+
+			struct Header {
+				uint32_t magic;
+				uint32_t version;
+				uint32_t objectCount;
+				uint32_t componentCount;
+				uint32_t paramCount;
+				uint32_t stringTableSize;
+				//byte offsets from the start of the file
+				uint32_t objectOffset;
+				uint32_t componentOffset;
+				uint32_t paramOffset;
+				uint32_t stringTableOffset;
+			};
+
+			struct ObjectRecord {
+				uint32_t	name;
+				uint32_t	tag;
+				uint32_t	parent;
+
+				float		position[3];
+				float		orientation[4];
+				float		scale[3];
+
+				uint32_t	mesh;
+				uint32_t	material;
+				uint32_t	texture;
+				uint32_t	animation;
+				float		renderScale;
+
+				//already zero for kinematic and near massless bodies
+				float		mass;
+				float		capsuleRadius;
+				float		capsuleHeight;
+
+				uint8_t		collider;
+				uint8_t		flags;
+				uint16_t	componentCount;
+				uint32_t	firstComponent;
+			};
+
+			struct ComponentRecord {
+				uint32_t name;
+				uint32_t nameHash;
+				uint32_t firstParam;
+				uint32_t paramCount;
+			};
+
+			struct ParamRecord {
+				uint32_t	key;
+				uint32_t	keyHash;
+				uint32_t	type;
+				//numbers and bools use the first value
+				float		values[3];
+				uint32_t	string;
+			};
+
+			static_assert(sizeof(Header) == 40, "LevelFormat::Header layout changed");
+			static_assert(sizeof(ObjectRecord) == 92, "LevelFormat::ObjectRecord layout changed");
+			static_assert(sizeof(ComponentRecord) == 16, "LevelFormat::ComponentRecord layout changed");
+			static_assert(sizeof(ParamRecord) == 28, "LevelFormat::ParamRecord layout changed");
+		}
+	}
+}
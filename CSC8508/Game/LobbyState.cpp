@@ -27,7 +27,7 @@ PushdownState::PushdownResult LobbyState::OnUpdate(float dt, PushdownState** new
 	if (game->IsExitLobbyTime()) {
 		gameStarted = true;
 		game->InitNetworkPlayers();
-		*newState = new PlayState(game, true);
+		*newState = new PlayState(game, true, game->GetSettings().level);
 		return PushdownResult::Push;
 	}
 
@@ -2,6 +2,13 @@
 #include "../../Common/Window.h"
 
 #include "Game.h"
+#include "LevelBaker.h"
+#include "../Engine/AllocationTracker.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
 
 using namespace NCL;
 using namespace CSC8508;
@@ -16,14 +23,120 @@ This time, we've added some extra functionality to the window class - we can
 hide or show the
 */
 
-int main() {
+/*
+Headless runs have no window, renderer or audio and step the game at a fixed rate:
+	-headless			play a single level until it is left, as fast as possible
+	-server				host matches, paced to real time. Implies -headless
+	-level N			level to play, starting from 1
+	-players N			remote players a server waits for before starting a match
+	-frames N			stop after N frames and print the frame times
+	-zeroalloc N		fail if any frame after the first N allocates
+
+	-bake file...		bake the listed level json files into .lvl files, then exit
+	-prefabs file...	turn repeated objects in the listed level json files into prefabs, then exit
+*/
+int RunHeadless(const GameSettings& settings, int frameLimit, int zeroAllocFrom) {
+	const float fixedDt = 1.0f / 60.0f;
+
+	Window* w = Window::CreateHeadlessWindow("Fall Bros. (headless)", 1280, 720);
+	Game* game = new Game(settings);
+
+	auto nextFrame = std::chrono::steady_clock::now();
+	double totalMs = 0.0;
+	float worstMs = 0.0f;
+	int frames = 0;
+
+	while (frameLimit == 0 || frames < frameLimit) {
+		w->UpdateWindow();
+
+		//UpdateGame starts by ending the frame before it, so frame N is judged during frame N + 1
+		if (zeroAllocFrom >= 0 && frames == zeroAllocFrom + 1)
+			AllocationTracker::SetExpectNoAllocations(true);
+
+		GameTimer frameTimer;
+		bool running = game->UpdateGame(fixedDt);
+		frameTimer.Tick();
+
+		totalMs += frameTimer.GetTimeDeltaMSec();
+		worstMs = std::max(worstMs, frameTimer.GetTimeDeltaMSec());
+		frames++;
+
+		if (!running)
+			break;
+
+		//batch runs go flat out, a server can't run the match faster than its clients
+		if (settings.server) {
+			nextFrame += std::chrono::microseconds((long long)(fixedDt * 1000000.0f));
+			std::this_thread::sleep_until(nextFrame);
+		}
+	}
+
+	//nothing ends the last frame, so it is judged here
+	if (zeroAllocFrom >= 0 && frames > zeroAllocFrom) {
+		AllocationTracker::SetExpectNoAllocations(true);
+		AllocationTracker::EndFrame();
+	}
+
+	std::cout << "Headless run: " << frames << " frames, " << (frames ? totalMs / frames : 0.0) << "ms average, "
+		<< worstMs << "ms worst" << std::endl;
+
+	delete game;
+	Window::DestroyGameWindow();
+
+	if (zeroAllocFrom >= 0) {
+		int failed = AllocationTracker::GetFailedFrameCount();
+		std::cout << "Steady state allocations: " << failed << " frames allocated" << std::endl;
+		return failed > 0 ? 1 : 0;
+	}
+	return 0;
+}
+
+int main(int argc, char** argv) {
+	GameSettings settings;
+	int frameLimit = 0;
+	int zeroAllocFrom = -1;
+
+	for (int i = 1; i < argc; ++i) {
+		bool hasValue = i + 1 < argc;
+		if (strcmp(argv[i], "-bake") == 0) {
+			bool baked = true;
+			while (++i < argc)
+				baked = LevelBaker::BakeFile(argv[i]) && baked;
+			return baked ? 0 : 1;
+		}
+		else if (strcmp(argv[i], "-prefabs") == 0) {
+			bool converted = true;
+			while (++i < argc)
+				converted = LevelBaker::MakePrefabs(argv[i]) && converted;
+			return converted ? 0 : 1;
+		}
+		else if (strcmp(argv[i], "-headless") == 0)
+			settings.headless = true;
+		else if (strcmp(argv[i], "-server") == 0)
+			settings.headless = settings.server = true;
+		else if (strcmp(argv[i], "-level") == 0 && hasValue)
+			settings.level = atoi(argv[++i]) - 1;
+		else if (strcmp(argv[i], "-players") == 0 && hasValue)
+			settings.serverPlayers = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-frames") == 0 && hasValue)
+			frameLimit = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-zeroalloc") == 0 && hasValue)
+			zeroAllocFrom = atoi(argv[++i]);
+		else
+			std::cout << "Unknown argument " << argv[i] << std::endl;
+	}
+
+	srand((unsigned int)time(0));
+
+	if (settings.headless)
+		return RunHeadless(settings, frameLimit, zeroAllocFrom);
+
 	Window* w = Window::CreateGameWindow("Fall Bros.", 1280, 720);
 
 	if (!w->HasInitialised()) {
 		return -1;
 	}
 
-	srand((unsigned int)time(0));
 	w->ShowOSPointer(false);
 	w->LockMouseToWindow(true);
 	Game* game = new Game();
@@ -1,5 +1,6 @@
 #pragma once
 #include"PlaySound.h"
+#include"ComponentFactory.h"
 #include"../Audio/SoundInstance.h"
 #include"../Audio/SoundManager.h"
 #include"../Engine/GameObject.h"
@@ -7,6 +8,13 @@
 using namespace NCL;
 using namespace CSC8508;
 
+namespace {
+	const bool registered = ComponentFactory::Register("PlaySound", [](GameObject* object, Game*, const ComponentParams& params) -> Component* {
+		return object->AddComponent<PlaySound>(params.GetString(LevelFormat::HashName("path")), params.GetInt(LevelFormat::HashName("mode")),
+			params.GetFloat(LevelFormat::HashName("volume")), params.GetFloat(LevelFormat::HashName("min")));
+	});
+}
+
 enum class PlaySound::PlayMode {
 	OnStart,
 	OnKill,
@@ -11,13 +11,15 @@
 #include "PlayerComponent.h"
 #include "../Engine/GameWorld.h"
 
+#include <algorithm>
+
 using namespace NCL;
 using namespace CSC8508;
 
-PlayState::PlayState(Game* game, bool isNetworked) {
+PlayState::PlayState(Game* game, bool isNetworked, int startLevel) {
 
 	this->isNetworked = isNetworked;
-	this->levelID = 0;
+	this->levelID = std::clamp(startLevel, 0, LEVELCOUNT - 1);
 	this->game = game;	
 	levels = new std::string[LEVELCOUNT]{ "Level1.json" , "Level2.json", "Level3.json" };
 
@@ -46,6 +48,11 @@ PushdownState::PushdownResult PlayState::OnUpdate(float dt, PushdownState** newS
 			*newState = new PauseState(game);
 			return PushdownResult::Push;
 		}
+
+		//the level is already loaded, so this restores it in place rather than reading it again
+		Debug::Print("Press R to restart the level", Vector2(1, 15));
+		if (Window::GetKeyboard()->KeyPressed(KeyboardKeys::R))
+			game->InitWorld(levels[levelID - 1]);
 	}
 	else {
 		Debug::Print("Press Tab to view scoreboard", Vector2(1, 10));
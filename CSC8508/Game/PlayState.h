@@ -15,7 +15,7 @@ namespace NCL {
 			void OnAwake() override;
 
 		public:
-			PlayState(Game* game, bool isNetworked = false);
+			PlayState(Game* game, bool isNetworked = false, int startLevel = 0);
 
 		protected:
 			void InitSpawns();
@@ -1,6 +1,8 @@
 #define NOMINMAX
 
 #include "PlayerComponent.h"
+#include "ComponentFactory.h"
+#include "../Engine/GameObject.h"
 
 #include "LocalNetworkPlayerComponent.h"
 #include "GameStateManagerComponent.h"
@@ -14,6 +16,7 @@
 #include "../Engine/GameWorld.h"
 #include "../Audio/SoundManager.h"
 #include "../Audio/SoundInstance.h"
+#include "../Engine/ComponentState.h"
 
 #include <algorithm>
 
@@ -21,6 +24,12 @@ using namespace NCL;
 using namespace CSC8508;
 using namespace Maths;
 
+namespace {
+	const bool registered = ComponentFactory::Register("Player", [](GameObject* object, Game* game, const ComponentParams&) -> Component* {
+		return object->AddComponent<PlayerComponent>(game);
+	});
+}
+
 PlayerComponent::PlayerComponent(GameObject* object, Game* game) : Component("PlayerComponent", object) 
 {
 	movementState = PlayerMovementState::WALKING;
@@ -92,15 +101,22 @@ void PlayerComponent::OnCollisionBegin(GameObject* otherObject)
 	ScoreComponent* score = ScoreComponent::instance;
 
 	if (score) {
-		if (otherObject->HasTag("Ring"))
-		{
-			score->AddScore(otherObject->GetComponent<RingComponent>()->GetBonus());
-			otherObject->OnKill();
-			return;
-		}
+		static const TagID goalTag = Tags::Intern("Goal");
+		if (otherObject->HasTag(goalTag)) GameStateManagerComponent::instance->SetPlayerFinished(true);
+	}
+}
 
-		if (otherObject->HasTag("Goal")) GameStateManagerComponent::instance->SetPlayerFinished(true);
+void PlayerComponent::OnTriggerEnter(GameObject* otherObject)
+{
+	if (!otherObject->IsActive()) return;
 
+	ScoreComponent* score = ScoreComponent::instance;
+
+	static const TagID ringTag = Tags::Intern("Ring");
+	if (score && otherObject->HasTag(ringTag))
+	{
+		score->AddScore(otherObject->GetComponent<RingComponent>()->GetBonus());
+		otherObject->OnKill();
 	}
 }
 
@@ -146,7 +162,8 @@ void NCL::CSC8508::PlayerComponent::CameraMovement()
 	camera->SetYaw(angles.y);
 	Quaternion cameraAngle = Quaternion::EulerAnglesToQuaternion(-pitch, angles.y, 0.0f);
 	Vector3 cameraOffset = cameraAngle * (Vector3(0, 0, 1) * cameraDistance);
-	Vector3 cameraFocusPoint = transform->GetPosition() + Vector3(0, 2, 0);
+	//Follow the interpolated position so the camera moves as smoothly as the rendered player
+	Vector3 cameraFocusPoint = transform->GetRenderPosition() + Vector3(0, 2, 0);
 
 	//Build ray from character camera if collision then move camera to ray position
 	camera->SetPosition(cameraFocusPoint + cameraOffset);
@@ -248,4 +265,32 @@ std::vector<std::string> PlayerComponent::DebugInfo() {
 	return returnVec;
 }
 
+void PlayerComponent::SaveState(StateWriter& state) const
+{
+	state.Write(movementState);
+	state.Write(direction);
+	state.Write(currentVelocity);
+	state.Write(receiveInputs);
+	state.Write(lockOrientation);
+	state.Write(yaw);
+	state.Write(pitch);
+	state.Write(cameraDistance);
+	state.Write(recquestedJump);
+	state.Write(jumpCounter);
+	state.Write(lastCollisionTimer);
+}
 
+void PlayerComponent::RestoreState(StateReader& state)
+{
+	state.Read(movementState);
+	state.Read(direction);
+	state.Read(currentVelocity);
+	state.Read(receiveInputs);
+	state.Read(lockOrientation);
+	state.Read(yaw);
+	state.Read(pitch);
+	state.Read(cameraDistance);
+	state.Read(recquestedJump);
+	state.Read(jumpCounter);
+	state.Read(lastCollisionTimer);
+}
@@ -39,8 +39,11 @@ namespace NCL {
 			void Start() override;
 			void Update(float dt) override;
 			void OnCollisionBegin(GameObject* otherObject) override;
+			void OnTriggerEnter(GameObject* otherObject) override;
 			void OnCollisionStay(GameObject* otherObject) override;
 			void OnCollisionEnd(GameObject* otherObject) override;
+			void SaveState(StateWriter& state) const override;
+			void RestoreState(StateReader& state) override;
 
 			PlayerMovementState GetCurrentMovementState()
 			{
@@ -3,6 +3,7 @@
 #include "../Engine/GameObject.h"
 #include "DisappearingPlatformComponent.h"
 #include "../Engine/Debug.h"
+#include "../Engine/Physics/PhysicsEngine/BulletWorld.h"
 using namespace NCL;
 using namespace CSC8508;
 using namespace physics;
@@ -14,7 +15,13 @@ NCL::CSC8508::PlayerRayFeetComponent::PlayerRayFeetComponent(GameObject* object,
 
 void NCL::CSC8508::PlayerRayFeetComponent::Update(float dt)
 {
-	GameObject* hit = game->Raycast(gameObject->GetTransform().GetPosition(), gameObject->GetTransform().GetPosition() + Vector3(0, -1, 0) * 1.2f);
+	//the probe is batched with every other ground check and cast during the physics update,
+	//so this reads back last frame's result and queues the next one
+	BulletWorld* physics = game->GetPhysics();
+	GameObject* hit = physics->getQueuedRayHit(rayTicket).object;
+
+	Vector3 position = gameObject->GetTransform().GetPosition();
+	rayTicket = physics->queueRay(position, position + Vector3(0, -1, 0) * 1.2f);
 
 	if (hit && hit->GetComponent<DisappearingPlatformComponent>())
 	{
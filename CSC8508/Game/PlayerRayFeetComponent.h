@@ -14,6 +14,8 @@ namespace NCL {
 
 		private:
 			Game* game;
+			//ground probe queued on the physics world last frame
+			int rayTicket = -1;
 		};
 	}
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "RespawnComponent.h"
+#include "ComponentFactory.h"
 
 #include "../Engine/Transform.h"
 #include "../Engine/GameObject.h"
@@ -8,6 +9,12 @@ using namespace NCL;
 using namespace CSC8508;
 using namespace Maths;
 
+namespace {
+	const bool registered = ComponentFactory::Register("Respawn", [](GameObject* object, Game*, const ComponentParams&) -> Component* {
+		return object->AddComponent<RespawnComponent>();
+	});
+}
+
 RespawnComponent::RespawnComponent(GameObject* object) : Component("RespawnComponent", object) {
 	spawnPosition = {};
 }
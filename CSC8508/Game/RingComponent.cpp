@@ -1,9 +1,16 @@
 #include "RingComponent.h"
+#include "ComponentFactory.h"
 #include "../Engine/GameObject.h"
 
 using namespace NCL;
 using namespace CSC8508;
 
+namespace {
+	const bool registered = ComponentFactory::Register("Ring", [](GameObject* object, Game*, const ComponentParams&) -> Component* {
+		return object->AddComponent<RingComponent>(10);
+	});
+}
+
 RingComponent::RingComponent(GameObject* object, int bonus) : Component("RingComponent", object)
 {
 	//active = true;
@@ -4,6 +4,7 @@
 #include "GameTechRenderer.h"
 #include "Game.h"
 #include "../Engine/GameWorld.h"
+#include "../Engine/ComponentState.h"
 #include "NetworkPlayerComponent.h"
 
 #include <algorithm>
@@ -31,14 +32,14 @@ void ScoreComponent::DisplayScoreboard(Game* game) {
 
 	std::sort(playerScores.begin(), playerScores.end(), [](ScorePair a, ScorePair b) {return a.second > b.second; });
 
-	game->getRenderer()->DrawString("Scoreboard:", Vector2(1, 30), Vector4(1.0f,1.0f,1.0f,1.0f), 15.0f);
+	game->DrawString("Scoreboard:", Vector2(1, 30), Vector4(1.0f,1.0f,1.0f,1.0f), 15.0f);
 
 	for (int i = 0; i < playerScores.size(); ++i)
 	{
 		string name = playerScores[i].first;
 		int score = playerScores[i].second;
 
-		game->getRenderer()->DrawString(name + ": " + std::to_string(score), Vector2(1, 34 + (i * 4)), Vector4(1.0f,1.0f,1.0f,1.0f), 15.0f);
+		game->DrawString(name + ": " + std::to_string(score), Vector2(1, 34 + (i * 4)), Vector4(1.0f,1.0f,1.0f,1.0f), 15.0f);
 	}
 
 
@@ -67,3 +68,21 @@ void ScoreComponent::AddScore(int val)
 {
 	this->score = std::max(0, (score + val));
 }
+
+void ScoreComponent::SaveState(StateWriter& state) const
+{
+	state.Write(score);
+	state.Write(hasFinished);
+}
+
+void ScoreComponent::RestoreState(StateReader& state)
+{
+	state.Read(score);
+	state.Read(hasFinished);
+}
+
+void ScoreComponent::Reset()
+{
+	score = 0;
+	hasFinished = false;
+}
@@ -24,6 +24,12 @@ namespace NCL {
 				void AddScore(int val);
 
 				bool IsFinished() const { return hasFinished; }
+
+				//the score object outlives levels, so a restart puts the score back through these
+				void SaveState(StateWriter& state) const override;
+				void RestoreState(StateReader& state) override;
+				//back to the score of a fresh game
+				void Reset();
 			private:
 				int score;
 				bool hasFinished = false;
@@ -1,5 +1,6 @@
 #pragma once
 #include"SetListener.h"
+#include"ComponentFactory.h"
 #include"../Engine/GameObject.h"
 #include"../Engine/PhysicsObject.h"
 #include"../Audio/SoundManager.h"
@@ -9,6 +10,12 @@
 using namespace NCL;
 using namespace CSC8508;
 
+namespace {
+	const bool registered = ComponentFactory::Register("SetListener", [](GameObject* object, Game*, const ComponentParams& params) -> Component* {
+		return object->AddComponent<SetListener>(params.GetInt(LevelFormat::HashName("ID")));
+	});
+}
+
 SetListener::SetListener(GameObject* object, int listenerID)
 	:Component("SetListener", object), object(object)
 {
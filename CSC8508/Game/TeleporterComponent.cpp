@@ -1,14 +1,22 @@
 #include "TeleporterComponent.h"
+#include "ComponentFactory.h"
 #include "../Engine/GameObject.h"
 using namespace NCL;
 using namespace CSC8508;
 
+namespace {
+	const bool registered = ComponentFactory::Register("Teleporter", [](GameObject* object, Game*, const ComponentParams& params) -> Component* {
+		return object->AddComponent<TeleporterComponent>(params.GetVector3(LevelFormat::HashName("target")));
+	});
+}
+
 TeleporterComponent::TeleporterComponent(GameObject* object, Maths::Vector3 target) : Component("TeleporterComponent", object) {
 	this->targetPosition = target;
 }
 
 void TeleporterComponent::OnCollisionStay(GameObject* other) {
-	if (other->HasTag("Player"))
+	static const TagID playerTag = Tags::Intern("Player");
+	if (other->HasTag(playerTag))
 	{
 		other->GetTransform().SetPosition(targetPosition);
 	//	other->GetPhysicsObject()->body->setLinearVelocity(Vector3(0, 0, 0));
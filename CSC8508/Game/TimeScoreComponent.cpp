@@ -1,8 +1,17 @@
 #include"TimeScoreComponent.h"
+#include"ComponentFactory.h"
+#include"../Engine/GameObject.h"
 #include "ScoreComponent.h"
+#include "../Engine/ComponentState.h"
 using namespace NCL;
 using namespace CSC8508;
 
+namespace {
+	const bool registered = ComponentFactory::Register("TimeScoreComponent", [](GameObject* object, Game*, const ComponentParams& params) -> Component* {
+		return object->AddComponent<TimeScoreComponent>(params.GetInt(LevelFormat::HashName("strength")), params.GetInt(LevelFormat::HashName("startingPoints")));
+	});
+}
+
 TimeScoreComponent::TimeScoreComponent(GameObject* object, int strength, int startingPoints)
 	: Component("TimeScoreComponent", object)
 {
@@ -26,4 +35,12 @@ void TimeScoreComponent::Start()
 	ScoreComponent::instance->AddScore(startingPoints);
 }
 
+void TimeScoreComponent::SaveState(StateWriter& state) const
+{
+	state.Write(timer);
+}
 
+void TimeScoreComponent::RestoreState(StateReader& state)
+{
+	state.Read(timer);
+}
@@ -14,6 +14,8 @@ namespace NCL {
 
 				void Update(float dt) override;
 				void Start() override;
+				void SaveState(StateWriter& state) const override;
+				void RestoreState(StateReader& state) override;
 			protected:
 				float timer;
 				int strength;
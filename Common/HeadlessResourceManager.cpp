@@ -0,0 +1,76 @@
+#include "HeadlessResourceManager.h"
+#include "MeshGeometry.h"
+#include "MeshMaterial.h"
+#include "MeshAnimation.h"
+
+using namespace NCL;
+using namespace NCL::Rendering;
+
+namespace {
+	//vertex data kept on the CPU for collision shapes and skinning, nothing is uploaded
+	class HeadlessMesh : public MeshGeometry {
+	public:
+		HeadlessMesh(const std::string& fileName) : MeshGeometry(fileName) {}
+
+		void UploadToGPU(RendererBase* renderer = nullptr) override {}
+	};
+}
+
+HeadlessResourceManager::~HeadlessResourceManager() {
+	for (auto m : loadedMeshes) {
+		delete m.second;
+	}
+	loadedMeshes.clear();
+
+	for (auto m : loadedMaterials) {
+		delete m.second;
+	}
+	loadedMaterials.clear();
+
+	for (auto m : loadedAnimations) {
+		delete m.second;
+	}
+	loadedAnimations.clear();
+}
+
+MeshGeometry* HeadlessResourceManager::LoadMesh(std::string fileName) {
+	if (loadedMeshes.find(fileName) != loadedMeshes.end())
+		return loadedMeshes[fileName];
+
+	MeshGeometry* mesh = new HeadlessMesh(fileName);
+	mesh->SetPrimitiveType(GeometryPrimitive::Triangles);
+
+	loadedMeshes.emplace(fileName, mesh);
+
+	return mesh;
+}
+
+MeshAnimation* HeadlessResourceManager::LoadAnimation(std::string fileName) {
+
+	if (fileName.empty())
+		return nullptr;
+
+	if (loadedAnimations.find(fileName) != loadedAnimations.end())
+		return loadedAnimations[fileName];
+
+	MeshAnimation* meshAnim = new MeshAnimation(fileName);
+
+	loadedAnimations.emplace(fileName, meshAnim);
+
+	return meshAnim;
+}
+
+//the layers keep their texture names, the textures themselves come back null
+MeshMaterial* HeadlessResourceManager::LoadMaterial(std::string fileName) {
+
+	if (loadedMaterials.find(fileName) != loadedMaterials.end())
+		return loadedMaterials[fileName];
+
+	MeshMaterial* material = new MeshMaterial(fileName);
+
+	material->LoadTextures(this);
+
+	loadedMaterials.emplace(fileName, material);
+
+	return material;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "ResourceManager.h"
+
+namespace NCL {
+
+	namespace Rendering {
+
+		//loads everything the simulation needs without a graphics context. Meshes, materials and
+		//animations are read into memory as normal, shaders and textures are never created
+		class HeadlessResourceManager : public ResourceManager {
+
+		public:
+
+			~HeadlessResourceManager();
+
+			NCL::MeshGeometry*	LoadMesh(std::string fileName) override;
+			ShaderBase*			LoadShader(std::string shaderVert, std::string shaderFrag, std::string shaderGeom = "") override { return nullptr; }
+			TextureBase*		LoadTexture(std::string textureName, unsigned int flags = 0, bool linearFilter = true, bool aniso = true) override { return nullptr; }
+			TextureBase*		LoadCubemap(std::string xPos, std::string xNeg, std::string yPos, std::string yNeg, std::string zPos, std::string zNeg, unsigned int flags = 0) override { return nullptr; }
+			MeshMaterial*		LoadMaterial(std::string fileName) override;
+			MeshAnimation*		LoadAnimation(std::string fileName) override;
+
+		private:
+			std::map<std::string, MeshGeometry*>	loadedMeshes;
+			std::map<std::string, MeshMaterial*>	loadedMaterials;
+			std::map<std::string, MeshAnimation*>	loadedAnimations;
+		};
+
+	}
+
+}
@@ -0,0 +1,10 @@
+#include "HeadlessWindow.h"
+
+using namespace NCL;
+
+HeadlessWindow::HeadlessWindow(const std::string& title, int sizeX, int sizeY) {
+	windowTitle	= title;
+	size		= Vector2((float)sizeX, (float)sizeY);
+	defaultSize	= size;
+	init		= true;
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include "Window.h"
+
+namespace NCL {
+	//a window with nothing behind it, for running without a display. It keeps the timer ticking
+	//and owns a keyboard and mouse that never see any input, so code reading input still works
+	class HeadlessWindow : public Window {
+	public:
+		friend class Window;
+
+		void	LockMouseToWindow(bool lock)	override {}
+		void	ShowOSPointer(bool show)		override {}
+
+	protected:
+		HeadlessWindow(const std::string& title, int sizeX, int sizeY);
+		~HeadlessWindow() {}
+
+		bool	InternalUpdate() override { return true; }
+	};
+}
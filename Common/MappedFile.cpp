@@ -0,0 +1,76 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace NCL;
+
+#ifdef _WIN32
+MappedFile::MappedFile(const std::string& fileName) {
+	data			= nullptr;
+	size			= 0;
+	mappingHandle	= nullptr;
+	fileHandle		= CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE) {
+		fileHandle = nullptr;
+		return;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+		return;
+
+	mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mappingHandle)
+		return;
+
+	data = (const char*)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	if (data)
+		size = (size_t)fileSize.QuadPart;
+}
+
+MappedFile::~MappedFile() {
+	if (data)
+		UnmapViewOfFile(data);
+	if (mappingHandle)
+		CloseHandle(mappingHandle);
+	if (fileHandle)
+		CloseHandle(fileHandle);
+}
+#else
+MappedFile::MappedFile(const std::string& fileName) {
+	data			= nullptr;
+	size			= 0;
+	fileDescriptor	= open(fileName.c_str(), O_RDONLY);
+	if (fileDescriptor < 0)
+		return;
+
+	struct stat fileStats;
+	if (fstat(fileDescriptor, &fileStats) != 0 || fileStats.st_size == 0)
+		return;
+
+	void* mapped = mmap(nullptr, (size_t)fileStats.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+	if (mapped == MAP_FAILED)
+		return;
+
+	data = (const char*)mapped;
+	size = (size_t)fileStats.st_size;
+}
+
+MappedFile::~MappedFile() {
+	if (data)
+		munmap((void*)data, size);
+	if (fileDescriptor >= 0)
+		close(fileDescriptor);
+}
+#endif
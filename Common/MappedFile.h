@@ -0,0 +1,31 @@
+#pragma once
+#include <string>
+#include <cstddef>
+
+namespace NCL {
+	//read only view of a whole file, mapped into memory rather than read. Pages are loaded by the
+	//OS as they are touched and are shared with anything else mapping the same file
+	class MappedFile {
+	public:
+		MappedFile(const std::string& fileName);
+		~MappedFile();
+
+		bool		IsOpen()	const { return data != nullptr; }
+		const char*	GetData()	const { return data; }
+		size_t		GetSize()	const { return size; }
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+	protected:
+		const char*	data;
+		size_t		size;
+
+#ifdef _WIN32
+		void*		fileHandle;
+		void*		mappingHandle;
+#else
+		int			fileDescriptor;
+#endif
+	};
+}
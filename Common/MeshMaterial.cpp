@@ -80,6 +80,15 @@ void MeshMaterial::LoadTextures(ResourceManager* manager) {
 	}
 }
 
+std::vector<string> MeshMaterial::GetTextureFiles() const {
+	std::vector<string> files;
+	for (auto& layer : meshLayers) {
+		for (auto& entry : layer->entries)
+			files.emplace_back(entry.second.first);
+	}
+	return files;
+}
+
 void MeshMaterialEntry::LoadTextures() {
 	for (auto& i : entries) {
 		string filename = Assets::TEXTUREDIR + i.second.first;
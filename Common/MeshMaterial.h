@@ -48,6 +48,9 @@ namespace NCL {
 		void LoadTextures();
 		void LoadTextures(Rendering::ResourceManager* manager);
 
+		//the texture files LoadTextures would load, a file can appear more than once
+		std::vector<string> GetTextureFiles() const;
+
 	protected:
 		std::vector<MeshMaterialEntry>	materialLayers;
 		std::vector<MeshMaterialEntry*> meshLayers;
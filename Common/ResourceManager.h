@@ -24,6 +24,14 @@ namespace NCL {
 			virtual TextureBase* LoadCubemap(std::string xPos, std::string xNeg, std::string yPos, std::string yNeg, std::string zPos, std::string zNeg, unsigned int flags = 0) = 0;
 			virtual MeshMaterial* LoadMaterial(std::string fileName) = 0;
 			virtual MeshAnimation* LoadAnimation(std::string fileName) = 0;
+
+			//read and decode a resource's files on a worker thread ahead of its Load call, which then
+			//only creates the API object. Can run alongside each other but not alongside Load calls.
+			//Managers that can't split loading just load everything in the Load calls
+			virtual void PreloadMesh(std::string fileName) {}
+			virtual void PreloadTexture(std::string textureName) {}
+			virtual void PreloadMaterial(std::string fileName) {}
+			virtual void PreloadAnimation(std::string fileName) {}
 		};
 	}
 }
\ No newline at end of file
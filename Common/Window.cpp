@@ -9,6 +9,7 @@
 #include "../Plugins/PlayStation4/PS4Window.h"
 #endif
 
+#include "HeadlessWindow.h"
 #include "RendererBase.h"
 
 using namespace NCL;
@@ -45,6 +46,16 @@ Window* Window::CreateGameWindow(std::string title, int sizeX, int sizeY, bool f
 #endif
 }
 
+Window* Window::CreateHeadlessWindow(std::string title, int sizeX, int sizeY) {
+	if (window) {
+		return nullptr;
+	}
+	Window* headless = new HeadlessWindow(title, sizeX, sizeY);
+	keyboard	= new Keyboard();
+	mouse		= new Mouse();
+	return headless;
+}
+
 void	Window::SetRenderer(RendererBase* r) {
 	if (renderer && renderer != r) {
 		renderer->OnWindowDetach();
@@ -29,6 +29,8 @@ namespace NCL {
 	class Window {
 	public:
 		static Window* CreateGameWindow(std::string title = "NCLGL!", int sizeX = 800, int sizeY = 600, bool fullScreen = false, int offsetX = 100, int offsetY = 100);
+		//no OS window or graphics context, for servers and batch runs
+		static Window* CreateHeadlessWindow(std::string title = "NCLGL!", int sizeX = 800, int sizeY = 600);
 
 		static void DestroyGameWindow() {
 			delete window;
@@ -7,9 +7,48 @@
 #include "../../Common/MeshAnimation.h"
 #include "../../Common/TextureLoader.h"
 
+#include <cstdlib>
+
 using namespace NCL::Rendering;
 
+namespace {
+	//finds a preloaded resource and hands it over, removing it from the preloaded map
+	template<typename T>
+	bool TakePreloaded(std::mutex& lock, std::map<std::string, T>& preloaded, const std::string& name, T& out) {
+		std::lock_guard<std::mutex> guard(lock);
+		auto found = preloaded.find(name);
+		if (found == preloaded.end())
+			return false;
+
+		out = found->second;
+		preloaded.erase(found);
+		return true;
+	}
+
+	//keeps the first of two threads to decode the same resource
+	template<typename T>
+	bool StorePreloaded(std::mutex& lock, std::map<std::string, T>& preloaded, const std::string& name, const T& value) {
+		std::lock_guard<std::mutex> guard(lock);
+		return preloaded.emplace(name, value).second;
+	}
+
+	template<typename T>
+	bool IsPreloaded(std::mutex& lock, const std::map<std::string, T>& preloaded, const std::string& name) {
+		std::lock_guard<std::mutex> guard(lock);
+		return preloaded.find(name) != preloaded.end();
+	}
+}
+
 OGLResourceManager::~OGLResourceManager() {
+	for (auto m : preloadedMeshes)
+		delete m.second;
+	for (auto m : preloadedMaterials)
+		delete m.second;
+	for (auto m : preloadedAnimations)
+		delete m.second;
+	for (auto t : preloadedTextures)
+		free(t.second.data);
+
 	for (auto m : loadedMeshes) {
 		delete m.second;
 	}
@@ -40,8 +79,11 @@ NCL::MeshGeometry* OGLResourceManager::LoadMesh(std::string fileName) {
 	if (loadedMeshes.find(fileName) != loadedMeshes.end())
 		return loadedMeshes[fileName];
 
-	OGLMesh* mesh = new OGLMesh(fileName);
-	mesh->SetPrimitiveType(GeometryPrimitive::Triangles);
+	OGLMesh* mesh = nullptr;
+	if (!TakePreloaded(preloadLock, preloadedMeshes, fileName, mesh)) {
+		mesh = new OGLMesh(fileName);
+		mesh->SetPrimitiveType(GeometryPrimitive::Triangles);
+	}
 	mesh->UploadToGPU();
 
 	loadedMeshes.emplace(fileName, mesh);
@@ -57,7 +99,9 @@ NCL::MeshAnimation* OGLResourceManager::LoadAnimation(std::string fileName) {
 	if (loadedAnimations.find(fileName) != loadedAnimations.end())
 		return loadedAnimations[fileName];
 
-	MeshAnimation* meshAnim = new MeshAnimation(fileName);
+	MeshAnimation* meshAnim = nullptr;
+	if (!TakePreloaded(preloadLock, preloadedAnimations, fileName, meshAnim))
+		meshAnim = new MeshAnimation(fileName);
 
 	loadedAnimations.emplace(fileName, meshAnim);
 
@@ -69,7 +113,9 @@ NCL::MeshMaterial* OGLResourceManager::LoadMaterial(std::string fileName) {
 	if (loadedMaterials.find(fileName) != loadedMaterials.end())
 		return loadedMaterials[fileName];
 
-	MeshMaterial* material = new MeshMaterial(fileName);
+	MeshMaterial* material = nullptr;
+	if (!TakePreloaded(preloadLock, preloadedMaterials, fileName, material))
+		material = new MeshMaterial(fileName);
 
 	material->LoadTextures(this);
 
@@ -98,7 +144,14 @@ TextureBase* OGLResourceManager::LoadTexture(std::string textureName, unsigned i
 	if (loadedTextures.find(textureName) != loadedTextures.end())
 		return loadedTextures[textureName];
 
-	TextureBase* tex = TextureLoader::LoadAPITexture(textureName);
+	TextureBase* tex = nullptr;
+	DecodedTexture decoded;
+	if (TakePreloaded(preloadLock, preloadedTextures, textureName, decoded)) {
+		tex = OGLTexture::RGBATextureFromData(decoded.data, decoded.width, decoded.height, decoded.channels);
+		free(decoded.data);
+	}
+	else
+		tex = TextureLoader::LoadAPITexture(textureName);
 
 	loadedTextures.emplace(textureName, tex);
 
@@ -107,4 +160,51 @@ TextureBase* OGLResourceManager::LoadTexture(std::string textureName, unsigned i
 
 TextureBase* OGLResourceManager::LoadCubemap(std::string xPos, std::string xNeg, std::string yPos, std::string yNeg, std::string zPos, std::string zNeg, unsigned int flags) {
 	return nullptr;
-}
\ No newline at end of file
+}
+
+//the loaded maps are only read here, Load calls don't run while preloading
+void OGLResourceManager::PreloadMesh(std::string fileName) {
+	if (loadedMeshes.find(fileName) != loadedMeshes.end() || IsPreloaded(preloadLock, preloadedMeshes, fileName))
+		return;
+
+	OGLMesh* mesh = new OGLMesh(fileName);
+	mesh->SetPrimitiveType(GeometryPrimitive::Triangles);
+
+	if (!StorePreloaded(preloadLock, preloadedMeshes, fileName, mesh))
+		delete mesh;
+}
+
+void OGLResourceManager::PreloadTexture(std::string textureName) {
+	if (loadedTextures.find(textureName) != loadedTextures.end() || IsPreloaded(preloadLock, preloadedTextures, textureName))
+		return;
+
+	DecodedTexture decoded = { nullptr, 0, 0, 0 };
+	int flags = 0;
+	if (!TextureLoader::LoadTexture(textureName, decoded.data, decoded.width, decoded.height, decoded.channels, flags))
+		return;
+
+	if (!StorePreloaded(preloadLock, preloadedTextures, textureName, decoded))
+		free(decoded.data);
+}
+
+void OGLResourceManager::PreloadMaterial(std::string fileName) {
+	if (loadedMaterials.find(fileName) != loadedMaterials.end() || IsPreloaded(preloadLock, preloadedMaterials, fileName))
+		return;
+
+	MeshMaterial* material = new MeshMaterial(fileName);
+	for (auto& texture : material->GetTextureFiles())
+		PreloadTexture(texture);
+
+	if (!StorePreloaded(preloadLock, preloadedMaterials, fileName, material))
+		delete material;
+}
+
+void OGLResourceManager::PreloadAnimation(std::string fileName) {
+	if (fileName.empty() || loadedAnimations.find(fileName) != loadedAnimations.end() || IsPreloaded(preloadLock, preloadedAnimations, fileName))
+		return;
+
+	MeshAnimation* meshAnim = new MeshAnimation(fileName);
+
+	if (!StorePreloaded(preloadLock, preloadedAnimations, fileName, meshAnim))
+		delete meshAnim;
+}
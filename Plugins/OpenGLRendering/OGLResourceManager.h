@@ -2,10 +2,14 @@
 
 #include "../../Common/ResourceManager.h"
 
+#include <mutex>
+
 namespace NCL {
 
 	namespace Rendering {
 
+		class OGLMesh;
+
 		class OGLResourceManager : public ResourceManager {
 
 		public:
@@ -19,7 +23,27 @@ namespace NCL {
 			MeshMaterial*		LoadMaterial(std::string fileName) override;
 			MeshAnimation*		LoadAnimation(std::string fileName) override;
 
+			void PreloadMesh(std::string fileName) override;
+			void PreloadTexture(std::string textureName) override;
+			void PreloadMaterial(std::string fileName) override;
+			void PreloadAnimation(std::string fileName) override;
+
 		private:
+			//pixels read by PreloadTexture, waiting for a context to upload them
+			struct DecodedTexture {
+				char*	data;
+				int		width;
+				int		height;
+				int		channels;
+			};
+
+			//decoded resources are kept here until their Load call picks them up
+			std::mutex								preloadLock;
+			std::map<std::string, OGLMesh*>		preloadedMeshes;
+			std::map<std::string, MeshMaterial*>	preloadedMaterials;
+			std::map<std::string, MeshAnimation*>	preloadedAnimations;
+			std::map<std::string, DecodedTexture>	preloadedTextures;
+
 			std::map<std::string, MeshGeometry*>	loadedMeshes;
 			std::map<std::string, MeshMaterial*>	loadedMaterials;
 			std::map<std::string, MeshAnimation*>	loadedAnimations;